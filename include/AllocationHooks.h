@@ -0,0 +1,113 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+// Replaces the global operator new and delete with versions that count every allocation
+// for AllocationCounter. Include this in exactly one source file of a program (a test
+// binary, a benchmark) to turn counting on; programs that never include it keep the
+// standard allocator and pay nothing.
+
+#ifndef ALLOCATION_HOOKS_H
+#define ALLOCATION_HOOKS_H
+
+#include "Memory.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace ML
+{
+namespace detail
+{
+    inline void* countedAllocate (std::size_t bytes) noexcept
+    {
+        recordAllocation (bytes);
+        return std::malloc (bytes > 0 ? bytes : 1);
+    }
+
+    inline void* countedAllocate (std::size_t bytes, std::align_val_t alignment) noexcept
+    {
+        recordAllocation (bytes);
+        const std::size_t align = std::max (static_cast<std::size_t> (alignment), sizeof (void*));
+#ifdef _WIN32
+        return _aligned_malloc (bytes > 0 ? bytes : 1, align);
+#else
+        void* ptr = nullptr;
+        return posix_memalign (&ptr, align, bytes > 0 ? bytes : 1) == 0 ? ptr : nullptr;
+#endif
+    }
+
+    inline void countedFree (void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+        {
+            recordDeallocation();
+            std::free (ptr);
+        }
+    }
+
+    inline void countedAlignedFree (void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+        {
+            recordDeallocation();
+#ifdef _WIN32
+            _aligned_free (ptr);
+#else
+            std::free (ptr);
+#endif
+        }
+    }
+
+    inline void* countedAllocateOrThrow (std::size_t bytes)
+    {
+        if (void* ptr = countedAllocate (bytes))
+        {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    inline void* countedAllocateOrThrow (std::size_t bytes, std::align_val_t alignment)
+    {
+        if (void* ptr = countedAllocate (bytes, alignment))
+        {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    static const bool allocationHooksRegistered = markAllocationHooksInstalled();
+}
+}
+
+void* operator new (std::size_t bytes) { return ML::detail::countedAllocateOrThrow (bytes); }
+void* operator new[] (std::size_t bytes) { return ML::detail::countedAllocateOrThrow (bytes); }
+void* operator new (std::size_t bytes, const std::nothrow_t&) noexcept { return ML::detail::countedAllocate (bytes); }
+void* operator new[] (std::size_t bytes, const std::nothrow_t&) noexcept { return ML::detail::countedAllocate (bytes); }
+void* operator new (std::size_t bytes, std::align_val_t alignment) { return ML::detail::countedAllocateOrThrow (bytes, alignment); }
+void* operator new[] (std::size_t bytes, std::align_val_t alignment) { return ML::detail::countedAllocateOrThrow (bytes, alignment); }
+void* operator new (std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept { return ML::detail::countedAllocate (bytes, alignment); }
+void* operator new[] (std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept { return ML::detail::countedAllocate (bytes, alignment); }
+
+void operator delete (void* ptr) noexcept { ML::detail::countedFree (ptr); }
+void operator delete[] (void* ptr) noexcept { ML::detail::countedFree (ptr); }
+void operator delete (void* ptr, std::size_t) noexcept { ML::detail::countedFree (ptr); }
+void operator delete[] (void* ptr, std::size_t) noexcept { ML::detail::countedFree (ptr); }
+void operator delete (void* ptr, const std::nothrow_t&) noexcept { ML::detail::countedFree (ptr); }
+void operator delete[] (void* ptr, const std::nothrow_t&) noexcept { ML::detail::countedFree (ptr); }
+void operator delete (void* ptr, std::align_val_t) noexcept { ML::detail::countedAlignedFree (ptr); }
+void operator delete[] (void* ptr, std::align_val_t) noexcept { ML::detail::countedAlignedFree (ptr); }
+void operator delete (void* ptr, std::size_t, std::align_val_t) noexcept { ML::detail::countedAlignedFree (ptr); }
+void operator delete[] (void* ptr, std::size_t, std::align_val_t) noexcept { ML::detail::countedAlignedFree (ptr); }
+void operator delete (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { ML::detail::countedAlignedFree (ptr); }
+void operator delete[] (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { ML::detail::countedAlignedFree (ptr); }
+
+#endif // ALLOCATION_HOOKS_H
@@ -0,0 +1,108 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ML
+{
+    /**
+     * @brief A monotonic region of memory sized once up front.
+     *
+     * Allocations bump a cursor through a single cache-line aligned block and are never
+     * freed individually; the whole block is released at once (or recycled with `reset`).
+     * Only trivially destructible types may live in an arena, since nothing runs their
+     * destructors.
+     */
+    class Arena
+    {
+    public:
+        static constexpr std::size_t alignment = 64;
+
+        Arena() = default;
+
+        explicit Arena (std::size_t capacityBytes)
+            : block (capacityBytes > 0 ? static_cast<std::byte*> (::operator new[] (capacityBytes, std::align_val_t (alignment))) : nullptr),
+              capacity (capacityBytes)
+        {
+        }
+
+        Arena (Arena&& other) noexcept
+            : block (std::move (other.block)),
+              capacity (std::exchange (other.capacity, 0)),
+              used (std::exchange (other.used, 0))
+        {
+        }
+
+        Arena& operator= (Arena&& other) noexcept
+        {
+            block = std::move (other.block);
+            capacity = std::exchange (other.capacity, 0);
+            used = std::exchange (other.used, 0);
+            return *this;
+        }
+
+        /**
+         * @brief Number of bytes `allocate<T> (count)` consumes, including alignment padding.
+         *
+         * Use this to size an arena exactly before carving it up.
+         */
+        template <typename T>
+        static constexpr std::size_t bytesFor (std::size_t count)
+        {
+            return (count * sizeof (T) + alignment - 1) & ~(alignment - 1);
+        }
+
+        /**
+         * @brief Reserve uninitialised, aligned storage for `count` objects of type T.
+         *
+         * Throws std::bad_alloc if the arena was sized too small.
+         */
+        template <typename T>
+        T* allocate (std::size_t count)
+        {
+            static_assert (std::is_trivially_destructible<T>::value, "Arena memory is never destructed");
+            static_assert (alignof (T) <= alignment, "Arena cannot satisfy this alignment");
+
+            const std::size_t bytes = bytesFor<T> (count);
+            if (bytes > capacity - used)
+            {
+                throw std::bad_alloc();
+            }
+
+            T* ptr = reinterpret_cast<T*> (block.get() + used);
+            used += bytes;
+            return ptr;
+        }
+
+        /**
+         * @brief Forget every allocation so the block can be carved up again.
+         */
+        void reset() { used = 0; }
+
+        std::size_t getCapacity() const { return capacity; }
+        std::size_t getUsed() const { return used; }
+
+    private:
+        struct AlignedDelete
+        {
+            void operator() (std::byte* ptr) const { ::operator delete[] (ptr, std::align_val_t (alignment)); }
+        };
+
+        std::unique_ptr<std::byte[], AlignedDelete> block;
+        std::size_t capacity = 0;
+        std::size_t used = 0;
+    };
+}
+
+#endif // ARENA_H
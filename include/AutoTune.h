@@ -0,0 +1,95 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef AUTO_TUNE_H
+#define AUTO_TUNE_H
+
+#include "Gemm.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief How to run batched inference for one topology and batch size on one machine.
+     *
+     * The blocking goes to gemm (applyTuningPlan installs it); numThreads is for the caller
+     * to pass to evaluate and friends. No setting changes results, only speed.
+     */
+    struct TuningPlan
+    {
+        GemmBlocking blocking = getDefaultGemmBlocking();
+        unsigned numThreads = 1;
+        double samplesPerSecond = 0.0;  // measured for this plan; 0 if it was never measured
+    };
+
+    // Install the plan's blocking for every later gemm call
+    bool applyTuningPlan (const TuningPlan& plan);
+
+    // The processor's model name, e.g. from /proc/cpuinfo; "unknown" where it cannot be read
+    const std::string& getCpuModel();
+
+    /**
+     * @brief Picks a TuningPlan per topology and batch size by measuring, and remembers it.
+     *
+     * The first tune for a topology and batch size times a handful of kernels, gemm tile
+     * sizes and thread counts on synthetic inputs and keeps the fastest. The winner is
+     * written to the cache directory under a key made of the CPU model, the core count, the
+     * topology and the batch size, so later runs on the same kind of machine load it instead
+     * of measuring again. A plan set with setOverride is returned as is, for reproducible
+     * runs that must not depend on timings:
+     *
+     * ```
+     * ML::AutoTuner tuner;
+     * ML::TuningPlan plan = tuner.tune ({784, 128, 10}, 64);
+     * ML::applyTuningPlan (plan);
+     * ML::evaluate (network, testSet, ML::Metric::All, plan.numThreads, 64);
+     * ```
+     */
+    class AutoTuner
+    {
+    public:
+        // An empty directory means defaultCacheDirectory()
+        explicit AutoTuner (std::string cacheDirectory = "");
+
+        TuningPlan tune (const std::vector<unsigned>& topology, std::size_t batchSize);
+
+        // Every later tune returns `plan` without measuring or touching the cache
+        void setOverride (const TuningPlan& plan);
+        void clearOverride();
+        bool hasOverride() const { return overridePlan != nullptr; }
+
+        // Rough wall-clock limit on measuring one plan
+        void setBudgetSeconds (double seconds) { budgetSeconds = seconds; }
+
+        // Where the plan for this topology and batch size is cached
+        std::string getPlanPath (const std::vector<unsigned>& topology, std::size_t batchSize) const;
+        const std::string& getCacheDirectory() const { return cacheDirectory; }
+
+        // How many plans this tuner has measured rather than loaded
+        std::size_t getMeasureCount() const { return measureCount; }
+
+        // $XDG_CACHE_HOME/tinyml, else $HOME/.cache/tinyml, else ./.tinyml-cache
+        static std::string defaultCacheDirectory();
+
+        static bool savePlan (const TuningPlan& plan, const std::string& key, const std::string& path);
+        static bool loadPlan (const std::string& path, const std::string& key, TuningPlan& plan);
+
+    private:
+        std::string getKey (const std::vector<unsigned>& topology, std::size_t batchSize) const;
+        TuningPlan measure (const std::vector<unsigned>& topology, std::size_t batchSize) const;
+
+        std::string cacheDirectory;
+        std::unique_ptr<TuningPlan> overridePlan;
+        double budgetSeconds = 0.5;
+        std::size_t measureCount = 0;
+    };
+}
+
+#endif // AUTO_TUNE_H
@@ -0,0 +1,48 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include "Model.h"
+#include <string>
+
+namespace ML
+{
+    /**
+     * @brief Generate a standalone C++ header that evaluates the network's current weights.
+     *
+     * The header depends only on <cmath>. It bakes in the topology as constants and every
+     * layer's weights as `alignas (64) constexpr` arrays. It also defines
+     *
+     * ```
+     * namespace <namespaceName>
+     * {
+     *     constexpr unsigned numInputs, numOutputs;
+     *     inline void predict (const double* input, double* output);
+     * }
+     * ```
+     *
+     * `predict` runs fixed-bound loops with the transfer function inlined and accumulates in
+     * the same order as `Network::feedForward`, so it reproduces `Model::getResult` exactly.
+     */
+    std::string generateModelHeader (const Network& network, const std::string& namespaceName);
+
+    /**
+     * @brief Write `generateModelHeader` to a file.
+     *
+     * @return true if the file was written.
+     */
+    bool exportModelHeader (const Network& network, const std::string& filename, const std::string& namespaceName);
+
+    inline bool exportModelHeader (const Model& model, const std::string& filename, const std::string& namespaceName)
+    {
+        return exportModelHeader (*model.getNetwork(), filename, namespaceName);
+    }
+}
+
+#endif // CODEGEN_H
@@ -0,0 +1,117 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef DATA_PARALLEL_H
+#define DATA_PARALLEL_H
+
+#include "Evaluate.h"
+#include "Network.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief A fixed set of processes on one host that sum arrays through POSIX shared memory.
+     *
+     * Processes find each other through a Unix socket. The first to bind it becomes rank 0.
+     * Rank 0 creates a shared-memory segment holding one slot per rank and hands every
+     * later arrival whose size and count match its rank and the segment's name. The
+     * segment stays mapped until the group is destroyed. A socket file nobody listens on,
+     * left by a crashed run, is removed; binding and connecting take a lock on
+     * socketPath + ".lock" so a host that is still starting up is never mistaken for one.
+     *
+     * An all-reduce is a reduce-scatter followed by an all-gather through the segment:
+     * 1. Every rank copies its array into its own slot.
+     * 2. Each rank sums one 1/worldSize slice across all the slots, in rank order, and
+     *    writes the slice of the result.
+     * 3. Each rank copies the whole result back.
+     * Every rank does an equal share of the adds and no array passes through a single
+     * bottleneck. Because the slices are summed in rank order, every rank gets the same
+     * bits. This is the shared-memory counterpart of a ring all-reduce: with every rank
+     * able to read every slot directly, there are no hops to pipeline. Ranks wait on
+     * barriers held in the segment, spinning briefly before they yield.
+     *
+     * POSIX only; elsewhere `join` reports an error.
+     */
+    class ProcessGroup
+    {
+    public:
+        /**
+         * @brief Join (or found) the group at socketPath. Blocks until all worldSize processes
+         * have arrived and mapped the segment, or fails after timeoutSeconds; if one of them
+         * fails partway, every other one fails too once the time is up.
+         *
+         * @param count Doubles per all-reduce; every process must pass the same value.
+         * @return The group, or nullptr with an error on cerr.
+         */
+        static std::unique_ptr<ProcessGroup> join (const std::string& socketPath, unsigned worldSize, std::size_t count,
+                                                   double timeoutSeconds = 30.0);
+
+        ~ProcessGroup();
+
+        ProcessGroup (const ProcessGroup&) = delete;
+        ProcessGroup& operator= (const ProcessGroup&) = delete;
+
+        /**
+         * @brief Replace values (count of them) with their sum over every rank. Every rank
+         * must call it the same number of times.
+         */
+        void allReduceSum (double* values);
+
+        // Wait until every rank has reached this point
+        void barrier();
+
+        unsigned getRank() const { return rank; }
+        unsigned getWorldSize() const { return worldSize; }
+        std::size_t getCount() const { return count; }
+
+    private:
+        struct Header;
+
+        ProcessGroup() = default;
+
+        unsigned rank = 0;
+        unsigned worldSize = 1;
+        std::size_t count = 0;
+        std::string segmentName;
+        void* mapping = nullptr;
+        std::size_t mappingBytes = 0;
+        Header* header = nullptr;
+        double* slots = nullptr;    // worldSize arrays of count
+        double* result = nullptr;   // count
+        unsigned barrierSense = 0;
+    };
+
+    /**
+     * @brief Synchronous data-parallel training of one network replica per process.
+     *
+     * Every epoch walks the dataset in global batches of batchSize samples. Within a batch,
+     * rank r takes samples r, r + worldSize, and so on, accumulating their gradients with
+     * `Network::accumulateGradient`. The group sums the gradients (and the losses). Every
+     * rank then applies the same mean gradient with `Network::applyGradient`. Replicas that
+     * start with the same weights therefore stay identical, and the result does not depend
+     * on how many processes share the work, apart from summation order.
+     *
+     * The group's count must be `dataParallelCount (network)`.
+     *
+     * @return The mean loss over the last epoch, the same on every rank; NaN (with an error
+     * on cerr) if the group or the dataset does not match the network.
+     */
+    double trainDataParallel (Network& network, ProcessGroup& group, const std::vector<Sample>& dataset,
+                              std::size_t batchSize, unsigned epochs);
+
+    // Doubles each all-reduce of trainDataParallel carries: the weight gradients and the loss
+    inline std::size_t dataParallelCount (const Network& network)
+    {
+        return network.getNumWeights() + 1;
+    }
+}
+
+#endif // DATA_PARALLEL_H
@@ -0,0 +1,91 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include "Network.h"
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief K networks of one topology, evaluated and trained together.
+     *
+     * Every value is stored interleaved across models: weight w of models 0..K-1 sits in
+     * K adjacent doubles, and so do activations and gradients. Each arithmetic step of
+     * `Network::feedForward` and `Network::backPropagate` then becomes one loop over the
+     * models, which the compiler vectorises. For small topologies such as 2-8-1, a single
+     * network leaves most SIMD lanes idle, so evaluating K models costs little more than one.
+     *
+     * Each model computes exactly what a Network with the same weights would. Weight masks
+     * and weight-norm training are not supported.
+     *
+     * Usage:
+     *
+     * ```
+     * ML::Ensemble ensemble ({2, 8, 1}, 16, ML::WeightInit::Xavier, 42);
+     * ensemble.feedForward ({0.0, 1.0});
+     * ensemble.backPropagate ({1.0});
+     *
+     * std::vector<double> mean, variance;
+     * ensemble.getMeanAndVariance (mean, variance);
+     * ```
+     */
+    class Ensemble
+    {
+    public:
+        /**
+         * @brief K models, model k initialised exactly like `Network (topology, init, seed + k)`.
+         */
+        Ensemble (const std::vector<unsigned>& topology, std::size_t numModels,
+                  WeightInit init = WeightInit::Uniform, std::uint64_t seed = Random::makeSeed());
+
+        void feedForward (const std::vector<double>& inputVals);
+
+        // Trains every model towards the same targets.
+        void backPropagate (const std::vector<double>& targetVals);
+
+        void getResults (std::size_t model, std::vector<double>& resultVals) const;
+
+        // Mean and population variance of each output across the models.
+        void getMeanAndVariance (std::vector<double>& mean, std::vector<double>& variance) const;
+
+        std::vector<double> getWeights (std::size_t model) const;
+        void putWeights (std::size_t model, const std::vector<double>& weights);
+        double getRecentAverageError (std::size_t model) const { return recentAverageErrors[model]; }
+
+        std::size_t size() const { return numModels; }
+        const std::vector<unsigned>& getTopology() const { return topology; }
+        std::size_t getNumWeights() const { return numWeights; }
+
+    private:
+        // Models are padded to a whole number of cache lines so every interleaved row is aligned
+        static constexpr std::size_t laneMultiple = Arena::alignment / sizeof (double);
+
+        double* activations (std::size_t layerNum) const { return values + activationOffsets[layerNum] * stride; }
+        double* gradients (std::size_t layerNum) const { return gradientValues + activationOffsets[layerNum] * stride; }
+
+        Arena arena;
+        std::vector<unsigned> topology;
+        std::size_t numModels;
+        std::size_t stride;
+        std::size_t numWeights = 0;
+
+        std::vector<std::size_t> weightOffsets;      // per layer, in weights
+        std::vector<std::size_t> activationOffsets;  // per layer, in neurons (bias included)
+
+        double* weights = nullptr;
+        double* deltaWeights = nullptr;
+        double* values = nullptr;
+        double* gradientValues = nullptr;
+
+        std::vector<double> recentAverageErrors;
+    };
+}
+
+#endif // ENSEMBLE_H
@@ -0,0 +1,88 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "Network.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ML
+{
+    // One training or evaluation example: input values and the target values for them.
+    using Sample = std::pair<std::vector<double>, std::vector<double>>;
+
+    // Metrics evaluate can compute, combined with |. Anything not asked for is skipped.
+    //  Accuracy:        with one output, whether prediction and target fall on the same
+    //                   side of 0.5; with several, whether their largest entries match
+    //  RMSE, MAE:       over every output of every sample
+    //  LogLoss:         cross-entropy of the targets under the predictions, clamped away
+    //                   from 0 and 1; meaningful when the network trains with a cross-entropy loss
+    //  ConfusionMatrix: counts of (target class, predicted class), classes as for Accuracy
+    enum class Metric : unsigned
+    {
+        Accuracy = 1,
+        RMSE = 2,
+        MAE = 4,
+        LogLoss = 8,
+        ConfusionMatrix = 16,
+        All = 31
+    };
+
+    inline Metric operator| (Metric a, Metric b)
+    {
+        return static_cast<Metric> (static_cast<unsigned> (a) | static_cast<unsigned> (b));
+    }
+
+    inline bool hasMetric (Metric set, Metric metric)
+    {
+        return (static_cast<unsigned> (set) & static_cast<unsigned> (metric)) != 0;
+    }
+
+    /**
+     * @brief Metrics over a dataset. Those not requested are left at zero or empty.
+     */
+    struct EvaluationResult
+    {
+        std::size_t numSamples = 0;
+        double accuracy = 0.0;
+        double rmse = 0.0;
+        double mae = 0.0;
+        double logLoss = 0.0;  // mean per sample
+
+        std::size_t numClasses = 0;                  // 2 for single-output networks
+        std::vector<std::size_t> confusionMatrix;   // numClasses x numClasses, row = target class
+
+        std::size_t getConfusion (std::size_t targetClass, std::size_t predictedClass) const
+        {
+            return confusionMatrix[targetClass * numClasses + predictedClass];
+        }
+    };
+
+    /**
+     * @brief Run the network over a dataset and reduce the requested metrics.
+     *
+     * The dataset is cut into fixed chunks of batches that threads claim in turn. Each
+     * batch goes through `Network::feedForwardBatch`, so the outputs match `feedForward`.
+     * Predictions are what `Network::getPredictions` would return for the network's loss.
+     * Each chunk keeps its own partial sums and each thread its own confusion counts, with
+     * no sharing until the end. The chunks are then combined in order, so the result
+     * does not depend on the thread count.
+     *
+     * The network's weights are read in place and must not change during the call.
+     *
+     * @param numThreads Threads to use; 0 uses every core.
+     * @param batchSize Samples per forward pass.
+     * @return The metrics; empty (with an error on cerr) if a sample does not match the topology.
+     */
+    EvaluationResult evaluate (const Network& network, const std::vector<Sample>& dataset, Metric metrics = Metric::All,
+                               unsigned numThreads = 0, std::size_t batchSize = 64);
+}
+
+#endif // EVALUATE_H
@@ -0,0 +1,88 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef GEMM_H
+#define GEMM_H
+
+#include <cstddef>
+
+namespace ML
+{
+    /**
+     * @brief Data cache sizes in bytes, detected once per process.
+     *
+     * Falls back to 32 KiB / 1 MiB / 8 MiB where the platform does not report them.
+     */
+    struct CacheSizes
+    {
+        std::size_t l1 = 32 * 1024;
+        std::size_t l2 = 1024 * 1024;
+        std::size_t l3 = 8 * 1024 * 1024;
+    };
+
+    const CacheSizes& getCacheSizes();
+
+    /**
+     * @brief Tile sizes used by gemm.
+     *
+     * By default they are derived from the cache sizes: a kc x nr panel of B plus an mr x kc
+     * panel of A fill about half of L1, an mc x kc block of A about half of L2, and a kc x nc
+     * block of B about half of L3. Products with fewer than minPackedRows rows skip the
+     * packing and run one gemvT per row instead.
+     */
+    struct GemmBlocking
+    {
+        static constexpr std::size_t mr = 4;  // micro-kernel rows
+        static constexpr std::size_t nr = 8;  // micro-kernel columns
+
+        std::size_t kc;
+        std::size_t mc;
+        std::size_t nc;
+        std::size_t minPackedRows = 0;
+    };
+
+    // The blocking gemm uses now
+    GemmBlocking getGemmBlocking();
+
+    // The blocking derived from the cache sizes
+    const GemmBlocking& getDefaultGemmBlocking();
+
+    /**
+     * @brief Replace the blocking for every later gemm call, e.g. with a tuned one.
+     *
+     * Results do not depend on the blocking, only speed does, so this is safe to call while
+     * other threads multiply. Returns false, leaving the blocking alone, unless kc > 0, mc is
+     * a positive multiple of mr and nc a positive multiple of nr.
+     */
+    bool setGemmBlocking (const GemmBlocking& blocking);
+    void resetGemmBlocking();
+
+    // All matrices are row-major, with ld* the distance between consecutive rows. Every
+    // output element accumulates its products in ascending k onto beta * C, so the result
+    // is the same as the obvious triple loop, bit for bit.
+
+    /**
+     * @brief C (m x n) = A (m x k) * B (k x n) + beta * C, with beta 0 or 1.
+     *
+     * Blocks A and B into the caches, packs them into contiguous panels and runs a
+     * register-blocked mr x nr micro-kernel over each tile.
+     */
+    void gemm (std::size_t m, std::size_t n, std::size_t k, const double* a, std::size_t lda,
+               const double* b, std::size_t ldb, double beta, double* c, std::size_t ldc);
+
+    /**
+     * @brief y (m) = A (m x n) * x (n) + beta * y: one dot product per row of A.
+     */
+    void gemv (std::size_t m, std::size_t n, const double* a, std::size_t lda, const double* x, double beta, double* y);
+
+    /**
+     * @brief y (n) = x (m) * A (m x n) + beta * y: a sum of the rows of A scaled by x.
+     */
+    void gemvT (std::size_t m, std::size_t n, const double* a, std::size_t lda, const double* x, double beta, double* y);
+}
+
+#endif // GEMM_H
@@ -0,0 +1,118 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief Fixed-size histogram of latencies in microseconds with ~10% resolution.
+     *
+     * Bucket i counts values in (1.1^(i-1), 1.1^i], which covers a microsecond to several
+     * hours in a few kilobytes and makes recording constant time. Percentiles are reported
+     * as the upper edge of the bucket they fall in. Not thread-safe; owners guard it.
+     */
+    class LatencyHistogram
+    {
+    public:
+        static constexpr std::size_t numBuckets = 256;
+
+        void record (double micros)
+        {
+            ++counts[bucketFor (micros)];
+            ++count;
+            sum += micros;
+            max = std::max (max, micros);
+        }
+
+        /**
+         * @brief The latency below which `fraction` (0..1) of recorded values fall.
+         */
+        double percentile (double fraction) const
+        {
+            if (count == 0)
+            {
+                return 0.0;
+            }
+
+            const auto rank = static_cast<std::uint64_t> (std::ceil (fraction * static_cast<double> (count)));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < numBuckets; ++i)
+            {
+                seen += counts[i];
+                if (seen >= std::max<std::uint64_t> (rank, 1))
+                {
+                    return std::min (upperEdge (i), max);
+                }
+            }
+            return max;
+        }
+
+        void merge (const LatencyHistogram& other)
+        {
+            for (std::size_t i = 0; i < numBuckets; ++i)
+            {
+                counts[i] += other.counts[i];
+            }
+            count += other.count;
+            sum += other.sum;
+            max = std::max (max, other.max);
+        }
+
+        void reset() { *this = LatencyHistogram(); }
+
+        std::uint64_t getCount() const { return count; }
+        double getMean() const { return count > 0 ? sum / static_cast<double> (count) : 0.0; }
+        double getMax() const { return max; }
+
+        /**
+         * @brief The non-empty buckets as (upper edge in microseconds, count) pairs.
+         */
+        std::vector<std::pair<double, std::uint64_t>> getBuckets() const
+        {
+            std::vector<std::pair<double, std::uint64_t>> buckets;
+            for (std::size_t i = 0; i < numBuckets; ++i)
+            {
+                if (counts[i] > 0)
+                {
+                    buckets.emplace_back (upperEdge (i), counts[i]);
+                }
+            }
+            return buckets;
+        }
+
+    private:
+        static constexpr double growth = 1.1;
+
+        static std::size_t bucketFor (double micros)
+        {
+            if (micros <= 1.0)
+            {
+                return 0;
+            }
+            const double index = std::ceil (std::log (micros) / std::log (growth));
+            return static_cast<std::size_t> (std::min (index, static_cast<double> (numBuckets - 1)));
+        }
+
+        static double upperEdge (std::size_t bucket) { return std::pow (growth, static_cast<double> (bucket)); }
+
+        std::array<std::uint64_t, numBuckets> counts {};
+        std::uint64_t count = 0;
+        double sum = 0.0;
+        double max = 0.0;
+    };
+}
+
+#endif // HISTOGRAM_H
@@ -0,0 +1,124 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef INFERENCE_EXECUTOR_H
+#define INFERENCE_EXECUTOR_H
+
+#include "Histogram.h"
+#include "Snapshot.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief Counters collected by an InferenceExecutor since it started (or was last reset).
+     */
+    struct InferenceStats
+    {
+        std::uint64_t numRequests = 0;
+        std::uint64_t numBatches = 0;
+        double meanBatchSize = 0.0;
+        double p50Micros = 0.0;                  // submit-to-result latency
+        double p99Micros = 0.0;
+        LatencyHistogram latency;
+        std::vector<std::uint64_t> batchSizes;   // batchSizes[n] = batches that held n requests
+    };
+
+    /**
+     * @brief Coalesces single-sample requests from many threads into batched forward passes.
+     *
+     * Each `submit` queues one input and returns a future for its output. A worker waits
+     * until either `maxBatchSize` requests are queued or the oldest one has waited `maxWait`,
+     * then evaluates the whole batch with `Network::feedForwardBatch` against the latest
+     * published weights. Raising either limit trades latency for throughput; `getStats`
+     * reports the latency percentiles and batch sizes needed to tune them.
+     *
+     * Usage:
+     *
+     * ```
+     * ML::InferenceExecutor executor (network, 32, std::chrono::microseconds (200));
+     *
+     * // any thread
+     * std::vector<double> result = executor.submit ({0.5, 1.0}).get();
+     * ```
+     */
+    class InferenceExecutor
+    {
+    public:
+        /**
+         * @brief Serve a copy of the network's current weights; refresh with `updateWeights`.
+         */
+        InferenceExecutor (const Network& network, std::size_t maxBatchSize = 32,
+                           std::chrono::microseconds maxWait = std::chrono::microseconds (200), unsigned numWorkers = 1);
+
+        /**
+         * @brief Serve whatever the publisher most recently published. The publisher must
+         * outlive the executor.
+         */
+        InferenceExecutor (const SnapshotPublisher& weights, std::size_t maxBatchSize = 32,
+                           std::chrono::microseconds maxWait = std::chrono::microseconds (200), unsigned numWorkers = 1);
+
+        /**
+         * @brief Finishes every queued request, then stops the workers.
+         */
+        ~InferenceExecutor();
+
+        InferenceExecutor (const InferenceExecutor&) = delete;
+        InferenceExecutor& operator= (const InferenceExecutor&) = delete;
+
+        /**
+         * @brief Queue one sample. The future throws std::invalid_argument if the input does
+         * not match the model's input layer, or std::runtime_error if no weights are published.
+         */
+        std::future<std::vector<double>> submit (std::vector<double> inputVals);
+
+        /**
+         * @brief Publish new weights for later batches. Only for executors built from a Network.
+         */
+        void updateWeights (const Network& network);
+
+        InferenceStats getStats() const;
+        void resetStats();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Request
+        {
+            std::vector<double> inputVals;
+            std::promise<std::vector<double>> result;
+            Clock::time_point submitted;
+        };
+
+        void start (unsigned numWorkers);
+        void run();
+        void execute (std::vector<Request>& batch, std::vector<double>& inputs, std::vector<double>& outputs);
+
+        std::unique_ptr<SnapshotPublisher> ownedWeights;
+        const SnapshotPublisher* weights;
+        const std::size_t maxBatchSize;
+        const std::chrono::microseconds maxWait;
+
+        std::mutex queueMutex;
+        std::condition_variable wakeUp;
+        std::deque<Request> queue;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+
+        mutable std::mutex statsMutex;
+        InferenceStats stats;
+    };
+}
+
+#endif // INFERENCE_EXECUTOR_H
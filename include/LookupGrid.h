@@ -0,0 +1,119 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef LOOKUP_GRID_H
+#define LOOKUP_GRID_H
+
+#include "Network.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ML
+{
+    // How LookupGrid fills in between its nodes.
+    //  Linear: multilinear over the 2^N surrounding nodes; never overshoots the node values
+    //  Cubic:  Catmull-Rom over the 4^N surrounding nodes; smoother and usually closer to
+    //          the network, at four times the loads per axis
+    enum class GridInterpolation
+    {
+        Linear,
+        Cubic
+    };
+
+    // One input's range and how many evenly spaced nodes cover it, ends included.
+    struct GridAxis
+    {
+        double low = 0.0;
+        double high = 1.0;
+        unsigned points = 33;
+    };
+
+    /**
+     * @brief How far the grid strays from the network it was baked from.
+     */
+    struct GridErrorReport
+    {
+        double maxError = 0.0;               // largest absolute difference over every output
+        double meanError = 0.0;              // mean absolute difference over every output
+        std::vector<double> worstInput;      // where maxError was found
+        std::size_t samplesChecked = 0;
+    };
+
+    /**
+     * @brief A network with one to three inputs baked into a dense grid of its outputs.
+     *
+     * Baking evaluates the network once at every node with `Network::feedForwardBatch`.
+     * A query then costs a few loads and multiply-adds per output instead of a full
+     * forward pass, which is what a UI dragging a point around a trained model wants.
+     * Nodes are stored one after another with their outputs side by side, so the values
+     * a query blends sit in a few cache lines.
+     *
+     * The grid remembers the network's weights version and re-bakes on the next query
+     * after any change, so it can stay enabled while the network trains. Inputs outside
+     * an axis are clamped to it.
+     *
+     * The network must outlive the grid.
+     */
+    class LookupGrid
+    {
+    public:
+        // Inputs the grid supports; the node count grows as points^inputs
+        static constexpr std::size_t maxInputs = 3;
+
+        /**
+         * @param axes One per network input, each with at least two points.
+         * If the network has more than maxInputs inputs or the axes do not match, the grid
+         * is left invalid with an error on cerr.
+         */
+        LookupGrid (const Network& network, std::vector<GridAxis> axes,
+                    GridInterpolation interpolation = GridInterpolation::Linear);
+
+        bool isValid() const { return valid; }
+
+        /**
+         * @brief Interpolate the network's outputs at inputVals, re-baking first if the
+         * weights have changed. outputVals receives one value per network output.
+         */
+        void query (const double* inputVals, double* outputVals);
+        void query (const std::vector<double>& inputVals, std::vector<double>& outputVals);
+
+        // Evaluate the network at every node now rather than on the next query
+        void bake();
+
+        /**
+         * @brief Compare the grid with the network at numSamples uniformly random points
+         * inside the axes.
+         */
+        GridErrorReport measureError (std::size_t numSamples = 10000, std::uint64_t seed = 1);
+
+        const std::vector<GridAxis>& getAxes() const { return axes; }
+        GridInterpolation getInterpolation() const { return interpolation; }
+        std::size_t getNumNodes() const { return numNodes; }
+        std::size_t getBakeCount() const { return bakeCount; }
+
+    private:
+        void refresh();
+        void queryLinear (const double* inputVals, double* outputVals) const;
+        void queryCubic (const double* inputVals, double* outputVals) const;
+
+        const Network& network;
+        std::vector<GridAxis> axes;
+        GridInterpolation interpolation;
+        bool valid = false;
+
+        std::size_t numOutputs = 0;
+        std::size_t numNodes = 0;
+        std::size_t strides[maxInputs] = {};  // in nodes; the first axis varies slowest
+        std::vector<double> values;           // numNodes x numOutputs
+        std::uint64_t bakedVersion = 0;
+        bool baked = false;
+        std::size_t bakeCount = 0;
+    };
+}
+
+#endif // LOOKUP_GRID_H
@@ -0,0 +1,58 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef LOSS_H
+#define LOSS_H
+
+#include <cstddef>
+
+namespace ML
+{
+    // What backPropagate minimises. The output layer always computes tanh (z) of its sums z;
+    // the losses differ in how they read those outputs.
+    //  MeanSquared:             (t - o)^2, reported as RMS; the original behaviour
+    //  MeanAbsolute:            |t - o|
+    //  Huber:                   squared within huberDelta of the target, absolute beyond it
+    //  BinaryCrossEntropy:      each output is an independent probability p = (1 + o) / 2,
+    //                           i.e. sigmoid (2z); targets in [0, 1]
+    //  CategoricalCrossEntropy: softmax over the sums z; targets a distribution, usually one-hot
+    enum class Loss
+    {
+        MeanSquared,
+        MeanAbsolute,
+        Huber,
+        BinaryCrossEntropy,
+        CategoricalCrossEntropy
+    };
+
+    const char* toString (Loss loss);
+
+    /**
+     * @brief Loss of one sample, and the gradients the output layer feeds back, in one pass.
+     *
+     * `gradients` receives -dL/dz for each output, the sign convention backPropagate uses.
+     * The cross-entropies work from the sums directly: softmax subtracts the largest sum
+     * before exponentiating and binary cross-entropy uses a stable softplus, so neither
+     * overflows or takes the log of zero however saturated the outputs are, and their
+     * gradients reduce to t - p with no tanh derivative to vanish.
+     *
+     * @param outputs The output layer's activations, tanh (sums).
+     * @param sums The output layer's weighted sums.
+     * @return The loss averaged over the outputs (summed over them for CategoricalCrossEntropy);
+     *         for MeanSquared the root of the mean, matching getRecentAverageError's history.
+     */
+    double computeLoss (Loss loss, std::size_t numOutputs, const double* outputs, const double* sums,
+                        const double* targets, double* gradients, double huberDelta = 1.0);
+
+    /**
+     * @brief What the loss reads the outputs as: probabilities for the cross-entropies, the
+     * outputs themselves otherwise.
+     */
+    void computePredictions (Loss loss, std::size_t numOutputs, const double* outputs, const double* sums, double* predictions);
+}
+
+#endif // LOSS_H
@@ -0,0 +1,102 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef MAPPED_MODEL_H
+#define MAPPED_MODEL_H
+
+#include "Network.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief A read-only model evaluated straight out of a memory-mapped file.
+     *
+     * `write` stores a network in a binary layout that needs no parsing: a small header
+     * (magic, format version, byte-order mark, loss, topology), zero padding up to a page
+     * boundary, then the weights as raw doubles in `Network::getWeightData` order. `open`
+     * maps the file read-only and runs the forward pass on the mapped weights in place.
+     * Opening costs the same however large the model is, and pages are read in as they are
+     * first touched.
+     *
+     * Every process that opens the same file maps the same page-cache pages. Workers on one
+     * host therefore share a single physical copy of the weights instead of each parsing
+     * its own. `write` replaces an existing file by renaming a new one over it, so processes
+     * that still have the old file open keep evaluating the old weights undisturbed.
+     *
+     * Files are written in the host's byte order and rejected on hosts with another.
+     * POSIX only; elsewhere `open` reports an error.
+     *
+     * Usage:
+     *
+     * ```
+     * // once, after training
+     * ML::MappedModel::write (network, "/srv/models/current.tml");
+     *
+     * // in every worker
+     * auto model = ML::MappedModel::open ("/srv/models/current.tml");
+     * std::vector<double> result = model->feedForward ({0.5, 1.0});
+     * ```
+     */
+    class MappedModel
+    {
+    public:
+        /**
+         * @brief Save the network's topology, loss and weights in the mapped layout.
+         *
+         * @return false, with an error on cerr, if the file could not be written.
+         */
+        static bool write (const Network& network, const std::string& path);
+
+        /**
+         * @brief Map a file written by `write`.
+         *
+         * @return The model, or nullptr with an error on cerr if the file is missing,
+         * truncated, or not in this layout.
+         */
+        static std::unique_ptr<MappedModel> open (const std::string& path);
+
+        ~MappedModel();
+
+        MappedModel (const MappedModel&) = delete;
+        MappedModel& operator= (const MappedModel&) = delete;
+
+        const std::vector<unsigned>& getTopology() const { return topology; }
+        Loss getLoss() const { return loss; }
+        std::size_t getNumWeights() const { return numWeights; }
+        std::size_t getFileBytes() const { return mappingBytes; }
+
+        // The weights inside the mapping, page aligned
+        const double* getWeightData() const { return weights; }
+
+        // The vector overloads return an empty vector when the input size does not match
+        std::vector<double> feedForward (const std::vector<double>& inputVals) const;
+        void feedForward (const double* inputVals, double* resultVals) const;
+        void feedForwardBatch (const double* inputVals, std::size_t batchSize, double* resultVals) const;
+
+        // What `Network::getPredictions` would give for these inputs under the stored loss
+        std::vector<double> predict (const std::vector<double>& inputVals) const;
+
+    private:
+        MappedModel() = default;
+
+        bool checkInputSize (std::size_t numInputs) const;
+
+        std::vector<unsigned> topology;
+        Loss loss = Loss::MeanSquared;
+        std::size_t numWeights = 0;
+        const void* mapping = nullptr;
+        std::size_t mappingBytes = 0;
+        const double* weights = nullptr;
+    };
+}
+
+#endif // MAPPED_MODEL_H
@@ -0,0 +1,133 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ML
+{
+    // Heap bytes held for one layer, by what they are for.
+    //  weights:     the layer's outgoing weight rows, plus weight-norm directions and gains
+    //  optimizer:   momentum (delta weights) for those rows
+    //  activations: outputs and gradients of the layer's neurons, in every precision in use
+    //  caches:      copies derived from the weights and rebuilt on demand, such as the
+    //               Mixed precision float weights
+    //  overhead:    neuron bookkeeping, alignment padding and unused container capacity
+    struct LayerMemory
+    {
+        std::size_t numNeurons = 0;  // including the bias neuron
+        std::size_t weightBytes = 0;
+        std::size_t optimizerBytes = 0;
+        std::size_t activationBytes = 0;
+        std::size_t cacheBytes = 0;
+        std::size_t overheadBytes = 0;
+
+        std::size_t total() const { return weightBytes + optimizerBytes + activationBytes + cacheBytes + overheadBytes; }
+    };
+
+    /**
+     * @brief Where a network's memory goes. The totals cover the layers plus storage that
+     * belongs to no single layer (the unused part of the arena, the incremental-forward
+     * cache, the network object itself), so total() is the network's whole footprint.
+     */
+    struct MemoryReport
+    {
+        std::vector<LayerMemory> layers;
+        std::size_t weightBytes = 0;
+        std::size_t optimizerBytes = 0;
+        std::size_t activationBytes = 0;
+        std::size_t cacheBytes = 0;
+        std::size_t overheadBytes = 0;
+
+        std::size_t total() const { return weightBytes + optimizerBytes + activationBytes + cacheBytes + overheadBytes; }
+    };
+
+    // One row per layer and a total row, in bytes.
+    std::string formatMemoryReport (const MemoryReport& report);
+
+    /**
+     * @brief Heap allocations counted on one thread.
+     */
+    struct AllocationStats
+    {
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        std::size_t bytes = 0;  // requested by the counted allocations
+    };
+
+    // True when the program includes AllocationHooks.h, so allocations are being counted
+    bool allocationHooksInstalled();
+
+    // Everything counted on the calling thread so far
+    AllocationStats threadAllocationStats();
+
+    /**
+     * @brief Counts the calling thread's heap allocations from construction onwards.
+     *
+     * Counts stay at zero unless the program defines the counting operator new and delete
+     * by including AllocationHooks.h in one source file. Tests use it to pin down what a
+     * call allocates:
+     *
+     * ```
+     * ML::AllocationCounter counter;
+     * network.trainStep (inputs, targets);
+     * EXPECT_EQ (counter.get().allocations, 0u);
+     * ```
+     */
+    class AllocationCounter
+    {
+    public:
+        AllocationCounter() : start (threadAllocationStats()) {}
+
+        AllocationStats get() const
+        {
+            const AllocationStats now = threadAllocationStats();
+            return { now.allocations - start.allocations, now.deallocations - start.deallocations, now.bytes - start.bytes };
+        }
+
+        void restart() { start = threadAllocationStats(); }
+
+    private:
+        AllocationStats start;
+    };
+
+    // What calling f allocates on this thread
+    template <typename Function>
+    AllocationStats countAllocations (Function&& f)
+    {
+        AllocationCounter counter;
+        std::forward<Function> (f)();
+        return counter.get();
+    }
+
+    namespace detail
+    {
+        // Called by the operators in AllocationHooks.h; they must not allocate
+        void recordAllocation (std::size_t bytes) noexcept;
+        void recordDeallocation() noexcept;
+        bool markAllocationHooksInstalled() noexcept;
+
+        template <typename T>
+        std::size_t heapBytes (const std::vector<T>& values)
+        {
+            return values.capacity() * sizeof (T);
+        }
+
+        template <typename T>
+        std::size_t unusedBytes (const std::vector<T>& values)
+        {
+            return (values.capacity() - values.size()) * sizeof (T);
+        }
+    }
+}
+
+#endif // MEMORY_H
@@ -8,11 +8,16 @@
 #ifndef MODEL_H
 #define MODEL_H
 
+#include "Evaluate.h"
+#include "MappedModel.h"
 #include "Network.h"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <cassert>
+#include <cstdlib>
+#include <limits>
 
 namespace ML
 {
@@ -25,7 +30,8 @@ namespace ML
      * 1. Initialize the Model with a topology (vector<unsigned>) defining the number of neurons in each layer.
      * 2. Use the `feedForward` method to pass inputs through the network.
      * 3. Use the `getResult` method to obtain the network's output.
-     * 4. Use the `backPropagate` method to train the network with target values.
+     * 4. Use the `backPropagate` method to train the network with target values, or `trainStep`
+     *    to do the forward pass and training for one sample in a single call.
      * 5. Save and load weights using `saveWeightsToFile` and `loadWeightsFromFile`.
      * 
      * Example:
@@ -56,9 +62,11 @@ namespace ML
          * @brief Constructor that initializes the model with the given topology.
          * 
          * @param tp The topology defining the number of neurons in each layer.
+         * @param init The weight initialisation scheme.
+         * @param seed Seed for the weights; models built with the same seed start identical.
          */
-        Model(const std::vector<unsigned>& tp) 
-            : thisNetwork(tp), topology(tp)
+        Model(const std::vector<unsigned>& tp, WeightInit init = WeightInit::Uniform, std::uint64_t seed = Random::makeSeed())
+            : thisNetwork(tp, init, seed), topology(tp)
         {
         }
 
@@ -66,14 +74,26 @@ namespace ML
          * @brief Set a new topology for the model.
          * 
          * This function allows you to change the network structure after initialization.
-         * However, if you change the topology, you'll need to reinitialize the network with the new topology.
+         * The network is rebuilt with freshly initialised weights, reusing its existing
+         * storage whenever the new topology fits in it.
          * 
          * @param tp A vector representing the new topology.
          */
         void setTopology(const std::vector<unsigned>& tp)
         {
             topology = tp;
-            thisNetwork = Network(tp);  // Reinitialize the network with the new topology
+            thisNetwork.setTopology(tp);  // Reinitialize the network with the new topology
+        }
+
+        /**
+         * @brief Redraw every weight of the network from the given scheme and seed.
+         * 
+         * @param init The weight initialisation scheme.
+         * @param seed Seed for the weights; the same seed always gives the same weights.
+         */
+        void initialiseWeights(WeightInit init, std::uint64_t seed)
+        {
+            thisNetwork.initialiseWeights(init, seed);
         }
 
         /**
@@ -86,6 +106,63 @@ namespace ML
             thisNetwork.backPropagate(targetVals);
         }
 
+        /**
+         * @brief Train on one sample: forward pass, loss, backward pass and weight update fused.
+         * 
+         * Equivalent to `feedForward (inputs)` followed by `backPropagate (targets)`, without
+         * copying the inputs or allocating. The update is already applied, so there is no
+         * need to call `updateWeights` afterwards.
+         * 
+         * @param inputs A vector of input values corresponding to the input layer of the network.
+         * @param targets The expected output values.
+         * @return The sample's loss under the loss chosen with `setLoss` (RMS error for
+         * MeanSquared), before the update; `getRecentAverageError` averages the same value.
+         */
+        double trainStep (const std::vector<double>& inputs, const std::vector<double>& targets)
+        {
+            assert (inputs.size() == topology.front());
+            assert (targets.size() == topology.back());
+            return thisNetwork.trainStep (inputs.data(), targets.data());
+        }
+
+        /**
+         * @brief Choose the loss that `backPropagate` and `trainStep` minimise.
+         * 
+         * @param loss The loss; MeanSquared unless set.
+         * @param huberDelta Where Loss::Huber turns from squared to absolute.
+         */
+        void setLoss (Loss loss, double huberDelta = 1.0)
+        {
+            thisNetwork.setLoss (loss, huberDelta);
+        }
+
+        /**
+         * @brief Set the step size of every later weight update; Neuron::eta unless set.
+         */
+        void setLearningRate (double learningRate)
+        {
+            thisNetwork.setLearningRate (learningRate);
+        }
+
+        /**
+         * @brief Set the momentum of every later weight update; Neuron::alpha unless set.
+         */
+        void setMomentum (double momentum)
+        {
+            thisNetwork.setMomentum (momentum);
+        }
+
+        /**
+         * @brief The last outputs as the loss reads them: probabilities for the cross-entropies,
+         * the same as `getResult` otherwise.
+         */
+        std::vector<double> getPredictions() const
+        {
+            std::vector<double> predictionVals;
+            thisNetwork.getPredictions (predictionVals);
+            return predictionVals;
+        }
+
         /**
          * @brief Get a pointer to the internal network.
          * 
@@ -98,6 +175,11 @@ namespace ML
             return &thisNetwork;
         }
 
+        const Network* getNetwork() const
+        {
+            return &thisNetwork;
+        }
+
         /**
          * @brief Get the current weights of the network.
          * 
@@ -111,6 +193,22 @@ namespace ML
             return weights;
         }
 
+        /**
+         * @brief Report the heap bytes held by this model, per layer and by purpose.
+         * 
+         * The network's report, plus the model's own copies: the weights cached by
+         * `getWeights` count as a cache, its topology and the object itself as overhead.
+         * 
+         * @return MemoryReport The footprint; see `ML::MemoryReport` for the categories.
+         */
+        MemoryReport getMemoryReport() const
+        {
+            MemoryReport report = thisNetwork.getMemoryReport();
+            report.cacheBytes += detail::heapBytes(weights);
+            report.overheadBytes += sizeof(Model) - sizeof(Network) + detail::heapBytes(topology);
+            return report;
+        }
+
         /**
          * @brief Perform forward propagation through the network with the given inputs.
          * 
@@ -124,6 +222,20 @@ namespace ML
             thisNetwork.feedForward (inputs);
         }
 
+        /**
+         * @brief Forward propagation that only redoes the work for inputs that changed.
+         * 
+         * Gives the same outputs as `feedForward`, but when few inputs differ from the
+         * previous call the first layer is updated incrementally instead of recomputed.
+         * 
+         * @param inputs A vector of input values corresponding to the input layer of the network.
+         */
+        void feedForwardIncremental (const std::vector<double>& inputs)
+        {
+            assert (inputs.size() == topology.front());
+            thisNetwork.feedForwardIncremental (inputs);
+        }
+
         /**
          * @brief Get the results (output values) from the network.
          * 
@@ -138,6 +250,21 @@ namespace ML
             return resultVals;
         }
 
+        /**
+         * @brief Compute metrics over a dataset, running batched forward passes on several threads.
+         * 
+         * Leaves the network's own state untouched. See `ML::evaluate` for the details.
+         * 
+         * @param dataset Samples whose sizes match the topology.
+         * @param metrics The metrics to compute, combined with |.
+         * @param numThreads Threads to use; 0 uses every core.
+         * @return The requested metrics.
+         */
+        EvaluationResult evaluate (const std::vector<Sample>& dataset, Metric metrics = Metric::All, unsigned numThreads = 0) const
+        {
+            return ML::evaluate (thisNetwork, dataset, metrics, numThreads);
+        }
+
         /**
          * @brief Set new weights for the network.
          * 
@@ -168,6 +295,8 @@ namespace ML
          * @brief Update the weights of the network.
          * 
          * This function applies updates to the weights based on the training (backpropagation) process.
+         * `backPropagate` and `trainStep` already apply their update, so calling this after them
+         * applies the stored momentum step a second time.
          */
         void updateWeights()
         {
@@ -206,6 +335,9 @@ namespace ML
                 return;
             }
 
+            // Write enough digits that loading gives back exactly the same weights
+            outFile.precision(std::numeric_limits<double>::max_digits10);
+
             const std::vector<double>& currentWeights = const_cast<Model*>(this)->getWeights();
             for (double weight : currentWeights)
             {
@@ -214,35 +346,96 @@ namespace ML
             outFile.close();
         }
 
+        /**
+         * @brief Save the model in the read-only layout `MappedModel::open` maps without parsing.
+         * 
+         * Use this to serve one copy of the weights to many processes on a host.
+         * 
+         * @param filename The file to write; an existing one is replaced atomically.
+         * @return true if the file was written.
+         */
+        bool saveMappedFile(const std::string& filename) const
+        {
+            return MappedModel::write(thisNetwork, filename);
+        }
+
         /**
          * @brief Load the network weights from a file.
          * 
-         * This function reads weights from a file and applies them to the network.
+         * This function reads weights from a file and applies them to the network. The file
+         * must hold exactly one weight per connection of this model's topology; anything else
+         * is rejected and leaves the current weights untouched.
          * 
          * @param filename The name of the file from which to load weights.
+         * @return true if the weights were loaded.
          */
-        void loadWeightsFromFile (const std::string& filename)
+        bool loadWeightsFromFile (const std::string& filename)
         {
-            std::ifstream inFile(filename);
-            if (!inFile)
+            std::vector<double> newWeights;
+            if (!readWeightsFile(filename, newWeights))
             {
-                std::cerr << "Error: Unable to open file for loading weights\n";
-                return;
+                std::cerr << "Error: Unable to read weights from " << filename << "\n";
+                return false;
             }
 
-            std::vector<double> newWeights;
-            double weight;
-            while (inFile >> weight)
+            if (newWeights.size() != thisNetwork.getNumWeights())
             {
-                newWeights.push_back(weight);
+                std::cerr << "Error: " << filename << " holds " << newWeights.size() << " weights but the topology needs "
+                          << thisNetwork.getNumWeights() << "\n";
+                return false;
             }
 
-            if (!newWeights.empty())
+            setWeights(newWeights);
+            return true;
+        }
+
+        /**
+         * @brief Parse a weights file written by `saveWeightsToFile`.
+         * 
+         * The whole file is read in one go and parsed in place. Parsing fails on anything
+         * that is not a finite number.
+         * 
+         * @param filename The file to read.
+         * @param weights Receives the weights in file order.
+         * @return true if the file could be opened and parsed completely.
+         */
+        static bool readWeightsFile (const std::string& filename, std::vector<double>& weights)
+        {
+            std::ifstream inFile(filename, std::ios::binary);
+            if (!inFile)
             {
-                setWeights(newWeights);
+                return false;
             }
 
-            inFile.close();
+            std::ostringstream contents;
+            contents << inFile.rdbuf();
+            const std::string text = contents.str();
+
+            weights.clear();
+            const char* cursor = text.c_str();
+            for (;;)
+            {
+                char* end = nullptr;
+                const double weight = std::strtod(cursor, &end);
+
+                if (end == cursor)
+                {
+                    // Nothing parsed: fine at the end of the file, malformed otherwise
+                    while (*cursor == ' ' || *cursor == '\n' || *cursor == '\r' || *cursor == '\t')
+                    {
+                        ++cursor;
+                    }
+                    return *cursor == '\0';
+                }
+
+                if (!std::isfinite(weight))
+                {
+                    return false;
+                }
+
+                weights.push_back(weight);
+                cursor = end;
+            }
         }
     };
 }
@@ -0,0 +1,112 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef MODEL_REGISTRY_H
+#define MODEL_REGISTRY_H
+
+#include "Snapshot.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief Serves a model while watching a directory for newer versions of it.
+     *
+     * A background thread polls the directory for the most recently modified weights file
+     * (as written by `Model::saveWeightsToFile`). When a new one appears it is parsed and
+     * validated against the registry's topology off the serving path, then swapped in
+     * atomically. Calls to `feedForward` that already started finish on the model they
+     * began with; later calls see the new one. Files that fail validation are reported and
+     * skipped until they change again.
+     *
+     * To deploy, write the new file under a temporary name and rename it into the directory
+     * so the watcher never sees it half written.
+     *
+     * Usage:
+     *
+     * ```
+     * ML::ModelRegistry registry ({2, 4, 1}, "/srv/models");
+     * registry.start();
+     *
+     * // any thread
+     * std::vector<double> result = registry.feedForward ({0.5, 1.0});
+     * ```
+     */
+    class ModelRegistry
+    {
+    public:
+        /**
+         * @param topology The topology every model file must match.
+         * @param directory The directory to watch.
+         * @param extension Only files with this extension are considered; empty for any file.
+         * @param pollInterval How often the background thread checks the directory.
+         */
+        ModelRegistry (std::vector<unsigned> topology, std::filesystem::path directory, std::string extension = ".txt",
+                       std::chrono::milliseconds pollInterval = std::chrono::milliseconds (500));
+        ~ModelRegistry();
+
+        ModelRegistry (const ModelRegistry&) = delete;
+        ModelRegistry& operator= (const ModelRegistry&) = delete;
+
+        /**
+         * @brief Load the current model (if any) and start watching in the background.
+         */
+        void start();
+        void stop();
+
+        /**
+         * @brief Check the directory once, loading a newer model if there is one.
+         *
+         * @return true if a new model was swapped in.
+         */
+        bool poll();
+
+        /**
+         * @brief Evaluate the current model. Returns an empty vector if no model is loaded yet.
+         */
+        std::vector<double> feedForward (const std::vector<double>& inputVals) const;
+
+        /**
+         * @brief Pin the current model, e.g. to run several evaluations against one version.
+         */
+        SnapshotPublisher::ReadGuard acquire() const { return publisher.acquire(); }
+
+        std::filesystem::path getCurrentPath() const;
+        std::uint64_t getNumReloads() const;
+
+    private:
+        void watch();
+
+        const std::vector<unsigned> topology;
+        const std::filesystem::path directory;
+        const std::string extension;
+        const std::chrono::milliseconds pollInterval;
+
+        SnapshotPublisher publisher;
+
+        mutable std::mutex pollMutex;
+        std::filesystem::path currentPath;
+        std::filesystem::path lastAttemptPath;
+        std::filesystem::file_time_type lastAttemptTime;
+        std::uintmax_t lastAttemptSize = 0;
+        std::uint64_t numReloads = 0;
+
+        std::mutex watchMutex;
+        std::condition_variable wakeUp;
+        bool running = false;
+        std::thread watcher;
+    };
+}
+
+#endif // MODEL_REGISTRY_H
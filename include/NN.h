@@ -11,53 +11,99 @@
 #include <vector>
 #include <memory>
 #include <cmath>
+#include <cstddef>
 
 namespace ML
 {
-    class Neuron;
-    using Layer = std::vector<std::unique_ptr<Neuron>>;
+    class Layer;
 
+    // A Neuron is a lightweight handle onto storage owned by its Network's arena:
+    // its output value, gradient and row of outgoing weights all live there.
     class Neuron
     {
     public:
-        Neuron(unsigned numOutputs, unsigned neuronIndex);
+        Neuron(unsigned numOutputs, unsigned neuronIndex, double* outputVal, double* gradient,
+               double* outputWeights, double* deltaWeights);
 
         void calcHiddenGradients(const Layer& nextLayer);
         void calcOutputGradients(double targetVal);
-        void feedForward(Layer& prevLayer);
-        void updateInputWeights(Layer& prevLayer);
+        void feedForward(const Layer& prevLayer);
+        void updateInputWeights(Layer& prevLayer, double learningRate = eta, double momentum = alpha);
 
         static double transferFunction(double x);
         static double transferFunctionDerivative(double x);
 
         double getOutputVal() const;
         void setOutputVal(double value);
+        double getGradient() const;
         int getIndex() const;
 
+        unsigned getNumOutputs() const { return numOutputs; }
+        double* getOutputWeights() { return outputWeights; }
+        const double* getOutputWeights() const { return outputWeights; }
+        double* getDeltaWeights() { return deltaWeights; }
+
+        static constexpr double eta = 0.15;   // learning rate
+        static constexpr double alpha = 0.5;  // momentum
+
     private:
-        double randomWeight();
         double sumDOW(const Layer& nextLayer) const;
 
-        double outputVal;
-        double gradient;
-        double error;
-        double recentAverageError;
+        double* outputVal;
+        double* gradient;
+        double* outputWeights;
+        double* deltaWeights;
+        unsigned numOutputs;
         unsigned index;
+    };
 
-        struct connection
+    // Non-owning view over one layer of a Network. The bias neuron is always last.
+    // Output values and gradients are contiguous per layer, and outgoing weights are
+    // stored row-major by source neuron: row i holds the getNumOutputs() weights of
+    // neuron i, which is also the order getWeights/putWeights serialise them in.
+    class Layer
+    {
+    public:
+        Layer(Neuron* neurons, unsigned numNeurons, unsigned numOutputs, double* outputVals,
+              double* gradients, double* outputWeights, double* deltaWeights)
+            : neurons(neurons), numNeurons(numNeurons), numOutputs(numOutputs), outputVals(outputVals),
+              gradients(gradients), outputWeights(outputWeights), deltaWeights(deltaWeights)
         {
-            double weight;
-            double deltaweight;
-        };
+        }
 
-        std::vector<std::unique_ptr<connection>> outputWeights;
+        std::size_t size() const { return numNeurons; }
 
-        static constexpr double eta = 0.15;   // learning rate
-        static constexpr double alpha = 0.5;  // momentum
+        Neuron& operator[](std::size_t n) { return neurons[n]; }
+        const Neuron& operator[](std::size_t n) const { return neurons[n]; }
+        Neuron& front() { return neurons[0]; }
+        const Neuron& front() const { return neurons[0]; }
+        Neuron& back() { return neurons[numNeurons - 1]; }
+        const Neuron& back() const { return neurons[numNeurons - 1]; }
+
+        Neuron* begin() { return neurons; }
+        Neuron* end() { return neurons + numNeurons; }
+        const Neuron* begin() const { return neurons; }
+        const Neuron* end() const { return neurons + numNeurons; }
 
-	public:
-		std::vector<std::unique_ptr<connection>> getOutputWeights() { return std::move(outputWeights); }
-	};
+        unsigned getNumOutputs() const { return numOutputs; }
+        double* getOutputVals() { return outputVals; }
+        const double* getOutputVals() const { return outputVals; }
+        double* getGradients() { return gradients; }
+        const double* getGradients() const { return gradients; }
+        double* getOutputWeights() { return outputWeights; }
+        const double* getOutputWeights() const { return outputWeights; }
+        double* getDeltaWeights() { return deltaWeights; }
+        const double* getDeltaWeights() const { return deltaWeights; }
+
+    private:
+        Neuron* neurons;
+        unsigned numNeurons;
+        unsigned numOutputs;
+        double* outputVals;
+        double* gradients;
+        double* outputWeights;
+        double* deltaWeights;
+    };
 }
 
 #endif // NN_H
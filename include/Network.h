@@ -8,28 +8,241 @@
 #ifndef NETWORK_H
 #define NETWORK_H
 
+#include "Arena.h"
+#include "Loss.h"
+#include "Memory.h"
 #include "NN.h"
+#include "Random.h"
+#include <cstdint>
 #include <vector>
 
 namespace ML
 {
+	// How initialiseWeights draws each layer's weights.
+	//  Uniform: uniform in [0, 1), the original scheme
+	//  Xavier:  uniform in +-sqrt (6 / (fanIn + fanOut)), suited to tanh
+	//  He:      uniform in +-sqrt (6 / fanIn), suited to rectifiers
+	enum class WeightInit
+	{
+		Uniform,
+		Xavier,
+		He
+	};
+
+	// Storage used by the member training passes.
+	//  Double: everything in double
+	//  Mixed:  float weights, activations and gradients; double accumulators and master weights
+	enum class Precision
+	{
+		Double,
+		Mixed
+	};
+
+	// Which weights normalizeWeights treats as one vector.
+	//  PerLayer:  every weight of a layer
+	//  PerNeuron: the incoming weights of each neuron
+	enum class NormScope
+	{
+		PerLayer,
+		PerNeuron
+	};
+
+	// An input given as (index, value) pairs; every input not listed is zero. Indices
+	// must be distinct and below the input layer's size, in any order.
+	struct SparseInput
+	{
+		std::vector<std::uint32_t> indices;
+		std::vector<double> values;
+	};
+
+	// All neurons, activations, gradients and weights of a Network live in one arena
+	// sized from the topology up front, so building or tearing down a network costs a
+	// handful of allocations regardless of its size. Weights (and their momentum terms)
+	// are one contiguous array in getWeights() order.
 	class Network
 	{
 	public:
-		Network (const std::vector <unsigned>& topology);
+		Network (const std::vector <unsigned>& topology, WeightInit init = WeightInit::Uniform, std::uint64_t seed = Random::makeSeed());
+		void setTopology (const std::vector <unsigned>& topology);
+		void initialiseWeights (WeightInit init, std::uint64_t seed);
 		void backPropagate (const std::vector <double>& targetVals);
 		void feedForward (std::vector <double> inputVals); //TODO: make const
+
+		// One training step: forward pass, loss, backward pass and weight update, reading
+		// the inputs and targets in place and allocating nothing. Returns this sample's loss
+		// under getLoss() (RMS for MeanSquared), the value backPropagate folds into
+		// getRecentAverageError. Leaves the network exactly as feedForward followed by
+		// backPropagate would.
+		double trainStep (const double* inputVals, const double* targetVals);
+		double trainStep (const std::vector <double>& inputVals, const std::vector <double>& targetVals);
+
+		// Data-parallel building blocks. accumulateGradient runs the forward and backward
+		// passes for one sample and adds its weight gradient (-dL/dw, in getWeights() order)
+		// to gradientSums, leaving the weights alone; it returns the sample's loss.
+		// applyGradient takes one momentum step along an averaged gradient, the same step
+		// backPropagate takes for a single sample. Both always work in double precision.
+		double accumulateGradient (const double* inputVals, const double* targetVals, double* gradientSums);
+		void applyGradient (const double* gradient);
+
+		// Same result as feedForward, but keeps the first hidden layer's pre-activations
+		// between calls. When only k of the n inputs differ from the previous call, those
+		// sums are updated with k weight-row axpys, so the first layer costs O(k*h) rather
+		// than O(n*h). Any change to the weights through this class drops the cache.
+		void feedForwardIncremental (const std::vector <double>& inputVals);
+
+		// Forward pass and training step for wide, mostly-zero inputs given as `count`
+		// (index, value) pairs. The first hidden layer's sums gather only the weight rows of
+		// the listed inputs, and the update writes only those rows, so the first layer costs
+		// O(count*h) however wide the input is. Absent inputs' rows keep their weights and
+		// their momentum until they next appear, as with lazy sparse optimizers. From zero
+		// momentum a step matches the dense trainStep. In Mixed precision feedForwardSparse
+		// falls back to the dense float pass, as feedForwardIncremental does; trainStepSparse
+		// always updates in double. A weight mask is honoured; weight norm is not supported,
+		// and trainStepSparse returns NaN without training while it is on.
+		void feedForwardSparse (const std::uint32_t* indices, const double* values, std::size_t count);
+		void feedForwardSparse (const SparseInput& input);
+		double trainStepSparse (const std::uint32_t* indices, const double* values, std::size_t count, const double* targetVals);
+		double trainStepSparse (const SparseInput& input, const std::vector <double>& targetVals);
+
+		// Drop everything derived from the weights (the incremental sums and the Mixed
+		// precision working copy). Call after editing weights through `layers` directly.
+		void invalidateCaches() { incrementalValid = false; workingWeightsValid = false; ++weightsVersion; }
+
+		// Changes whenever the weights do, so caches built outside the network (such as a
+		// LookupGrid) can tell when they are stale.
+		std::uint64_t getWeightsVersion() const { return weightsVersion; }
+
+		// In Mixed precision the member feedForward and backPropagate read float copies of
+		// the weights, activations and gradients, halving the memory they stream, while
+		// every dot product accumulates in double and the optimizer updates the double
+		// weights (the master copy returned by getWeights). Other passes are unaffected.
+		void setPrecision (Precision newPrecision);
+		Precision getPrecision() const { return precision; }
 		void getResults (std::vector <double>& resultVals) const;
+
+		// The loss backPropagate and trainStep minimise and getRecentAverageError reports.
+		// huberDelta is only read by Loss::Huber.
+		void setLoss (Loss newLoss, double newHuberDelta = 1.0) { loss = newLoss; huberDelta = newHuberDelta; }
+		Loss getLoss() const { return loss; }
+
+		// Step size and momentum of every weight update this network makes, whatever the
+		// path or precision. They default to Neuron::eta and Neuron::alpha.
+		void setLearningRate (double newLearningRate) { learningRate = newLearningRate; }
+		double getLearningRate() const { return learningRate; }
+		void setMomentum (double newMomentum) { momentum = newMomentum; }
+		double getMomentum() const { return momentum; }
+
+		// The last forward pass's outputs as the loss reads them: class or per-output
+		// probabilities for the cross-entropies, the same as getResults otherwise.
+		void getPredictions (std::vector <double>& predictionVals) const;
 		void putWeights (const std::vector<double>& weights);
 		void updateWeights();
-		void normalizeWeights (int connection_index);
+		void normalizeWeights (int connection_index); // centres and unit-normalises one neuron's incoming weights across all layers
+
+		// Centre (optionally) and rescale weight vectors to an L2 norm of targetNorm. Bias
+		// weights are left alone. One pass gathers the statistics and one rewrites the weights,
+		// both along contiguous rows, so the cost is about that of a forward pass.
+		void normalizeWeights (NormScope scope, bool centre = true, double targetNorm = 1.0);
+
+		// Weight-norm reparametrisation: while enabled, each neuron's incoming weights are
+		// trained as w = g * v / |v|. backPropagate and updateWeights turn the update they
+		// apply into updates of the gain g and the direction v, so a weight vector's length
+		// and direction are learnt separately. Enabling it takes g and v from the current weights.
+		void setWeightNorm (bool enabled);
+		bool getWeightNorm() const { return weightNorm; }
+		const std::vector<double>& getWeightNormGains() const { return weightNormGains; } // one per non-input neuron
 		std::vector<Layer>& GetLayers() { return layers; }
 		double getRecentAverageError (void) const { return recentAverageError; }
 
 		std::vector<double> getWeights() const;
+		const double* getWeightData() const { return weights; }
+
+		// Stateless forward pass over weights laid out as getWeights() returns them. Safe to
+		// call concurrently; each thread keeps its own scratch activations.
+		static void feedForward (const std::vector<unsigned>& topology, const double* weights,
+		                         const double* inputVals, double* resultVals);
+
+		// Batched form of the above: inputVals holds batchSize samples back to back and
+		// resultVals receives batchSize output vectors the same way. Each weight row is
+		// loaded once per batch rather than once per sample; results match feedForward exactly.
+		// resultSums, if given, receives the output layer's sums before tanh in the same layout.
+		static void feedForwardBatch (const std::vector<unsigned>& topology, const double* weights,
+		                              const double* inputVals, std::size_t batchSize, double* resultVals,
+		                              double* resultSums = nullptr);
+
+		// Optional per-weight mask in getWeights() order: weights whose mask entry is 0 are
+		// held at zero through every later update, e.g. after pruning. An empty mask
+		// disables masking.
+		void setWeightMask (std::vector<unsigned char> mask);
+		const std::vector<unsigned char>& getWeightMask() const { return weightMask; }
+
+		const std::vector<unsigned>& getTopology() const { return topology; }
+		std::size_t getNumWeights() const { return numWeights; }
+		std::size_t getArenaBytes() const { return arena.getCapacity(); }
+
+		// Heap bytes held by this network, per layer and by purpose; see MemoryReport.
+		MemoryReport getMemoryReport() const;
+		std::uint64_t getSeed() const { return seed; }
+		WeightInit getWeightInit() const { return weightInit; }
+
+		// Bytes of arena needed to hold a network of the given topology.
+		static std::size_t requiredBytes (const std::vector<unsigned>& topology);
+
+		// Weights a network of the given topology holds, and where each layer's block of them
+		// starts in getWeights() order: one offset per weight layer, then the total.
+		static std::size_t countWeights (const std::vector<unsigned>& topology);
+		static std::vector<std::size_t> layerWeightOffsets (const std::vector<unsigned>& topology);
 
 		std::vector <Layer> layers;
 	private:
+		void build();
+		void applyWeightMask (const std::uint32_t* activeInputs = nullptr, std::size_t numActive = 0);
+		void syncWeightNorm();
+		void applyWeightNormUpdate();
+		void prepareWorkingStorage();
+		void forwardDouble (std::size_t firstLayer = 1);
+		void writeDenseInputs (const double* inputVals);
+		void feedForwardMixed();
+		void computeOutputGradients (const double* targetVals);
+		void backPropagateFrom (const double* targetVals);
+		void backPropagateDouble (double* gradientSums, const std::uint32_t* activeInputs = nullptr, std::size_t numActive = 0);
+		void backPropagateMixed();
+
+		Arena arena;
+		std::vector<unsigned> topology;
+		double* weights = nullptr;
+		double* deltaWeights = nullptr;
+		double* outputSums = nullptr;             // output layer sums before tanh, for the losses
+		std::size_t numWeights = 0;
+		WeightInit weightInit;
+		std::uint64_t seed;
+		std::vector<unsigned char> weightMask;
+
+		std::vector<double> incrementalInputs;   // inputs the cached sums were built from
+		std::vector<double> incrementalSums;     // first hidden layer pre-activations
+		bool incrementalValid = false;
+		std::uint64_t weightsVersion = 0;
+		unsigned incrementalUpdates = 0;         // axpy updates since the last full rebuild
+
+		std::vector<std::uint32_t> sparseActive; // inputs the last sparse pass set non-zero
+		bool sparseInputsClean = false;          // every other input is zero
+
+		bool weightNorm = false;
+		std::vector<double> weightNormDirections; // v, laid out like weights
+		std::vector<double> weightNormGains;      // g
+
+		Precision precision = Precision::Double;
+		std::vector<float> workingWeights;        // float copy of weights, for Mixed passes
+		std::vector<float> workingValues;         // activations of every layer, bias included
+		std::vector<float> workingGradients;
+		std::vector<std::size_t> neuronOffsets;   // where each layer starts in workingValues
+		bool workingWeightsValid = false;
+
+		Loss loss = Loss::MeanSquared;
+		double huberDelta = 1.0;
+		double learningRate = Neuron::eta;
+		double momentum = Neuron::alpha;
+
 		double gradient = 0.0;
 		double error = 0.0;
 		double recentAverageError = 0.0;
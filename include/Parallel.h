@@ -0,0 +1,106 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief Number of worker threads to use when the caller does not specify one.
+     */
+    inline unsigned defaultThreadCount()
+    {
+        return std::max (1u, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * @brief Waiting strategy for polling loops: spin briefly, then yield, then nap, so an
+     * idle waiter does not hold a core forever.
+     */
+    class Backoff
+    {
+    public:
+        void wait()
+        {
+            if (++spins < 64)
+            {
+                return;
+            }
+            if (spins < 1024)
+            {
+                std::this_thread::yield();
+                return;
+            }
+            std::this_thread::sleep_for (std::chrono::microseconds (50));
+        }
+
+        void reset() { spins = 0; }
+
+    private:
+        unsigned spins = 0;
+    };
+
+    /**
+     * @brief Run `task (i)` for every i in [0, numTasks) across up to `numThreads` threads.
+     *
+     * Tasks are handed out dynamically, so uneven tasks balance themselves. The calling
+     * thread takes part in the work, and the call returns once every task has finished.
+     * Pass 0 threads to use every core.
+     */
+    template <typename Function>
+    void parallelFor (std::size_t numTasks, Function&& task, unsigned numThreads = 0)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = defaultThreadCount();
+        }
+
+        numThreads = static_cast<unsigned> (std::min<std::size_t> (numThreads, numTasks));
+
+        if (numThreads <= 1)
+        {
+            for (std::size_t i = 0; i < numTasks; ++i)
+            {
+                task (i);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> nextTask { 0 };
+        auto worker = [&]
+        {
+            for (std::size_t i = nextTask.fetch_add (1); i < numTasks; i = nextTask.fetch_add (1))
+            {
+                task (i);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve (numThreads - 1);
+        for (unsigned t = 1; t < numThreads; ++t)
+        {
+            threads.emplace_back (worker);
+        }
+
+        worker();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+#endif // PARALLEL_H
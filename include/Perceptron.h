@@ -6,7 +6,9 @@
 *****************************************************************************/
 
 #pragma once
+#include "LookupGrid.h"
 #include "Model.h"
+#include <memory>
 
 namespace ML
 {
@@ -15,7 +17,8 @@ namespace Models
     class Perceptron : public Model
     {
     public:
-        Perceptron (std::vector<unsigned> topology) : Model (topology)
+        Perceptron (std::vector<unsigned> topology, WeightInit init = WeightInit::Uniform, std::uint64_t seed = Random::makeSeed())
+            : Model (topology, init, seed)
         {
             setTopology (topology);
         }
@@ -66,6 +69,32 @@ namespace Models
             }
         }
 
+        //The lookup grid refers to the network it was built on, so a moved
+        //LinReg2D builds a fresh one over its own network with the same settings.
+        LinReg2D (LinReg2D&& other)
+            : Perceptron (std::move (other)),
+              valuesToLearn (std::move (other.valuesToLearn)),
+              xAxisValue (other.xAxisValue),
+              yAxisValue (other.yAxisValue),
+              results (std::move (other.results))
+        {
+            rebuildLookupGrid (other.lookupGrid);
+        }
+
+        LinReg2D& operator= (LinReg2D&& other)
+        {
+            if (this != &other)
+            {
+                Perceptron::operator= (std::move (other));
+                valuesToLearn = std::move (other.valuesToLearn);
+                xAxisValue = other.xAxisValue;
+                yAxisValue = other.yAxisValue;
+                results = std::move (other.results);
+                rebuildLookupGrid (other.lookupGrid);
+            }
+            return *this;
+        }
+
         void setValuesToLearn(std::vector<double> values)
         {
             valuesToLearn = values;
@@ -91,13 +120,61 @@ namespace Models
             learnSupervised (Parameters);
         }
 
+        //Moving the dot usually changes only one axis, so between weight
+        //updates only the first layer's sums for the axis that moved are redone.
         void calculateResult()
         {
+            if (lookupGrid != nullptr)
+            {
+                lookupGrid->query ({ xAxisValue, yAxisValue }, results);
+                return;
+            }
+
+            feedForwardIncremental ({ xAxisValue, yAxisValue });
             results = getResult();
         }
 
+        //Answers calculateResult from a grid of pointsPerAxis x pointsPerAxis
+        //precomputed outputs over [low, high] on both axes instead of a forward pass.
+        //The grid re-bakes itself on the next query after any learning.
+        //Check getLookupGrid()->measureError() to pick a resolution.
+        void enableLookupGrid (unsigned pointsPerAxis = 65, GridInterpolation interpolation = GridInterpolation::Linear,
+                               double low = 0.0, double high = 1.0)
+        {
+            const GridAxis axis { low, high, pointsPerAxis };
+            lookupGrid = std::make_unique<LookupGrid> (*getNetwork(), std::vector<GridAxis> { axis, axis }, interpolation);
+            if (!lookupGrid->isValid())
+            {
+                lookupGrid.reset();
+            }
+        }
+
+        void disableLookupGrid()
+        {
+            lookupGrid.reset();
+        }
+
+        LookupGrid* getLookupGrid()
+        {
+            return lookupGrid.get();
+        }
+
         //To Do:: Make labelX position itself on X axis
         // Make labelY position itself on Y axis
+
+    private:
+        void rebuildLookupGrid (std::unique_ptr<LookupGrid>& movedFrom)
+        {
+            lookupGrid.reset();
+            if (movedFrom != nullptr)
+            {
+                lookupGrid = std::make_unique<LookupGrid> (*getNetwork(), movedFrom->getAxes(), movedFrom->getInterpolation());
+                movedFrom.reset();
+            }
+        }
+
+        //Refers to this model's network; the move operations rebuild it
+        std::unique_ptr<LookupGrid> lookupGrid;
     };
 }
 }
@@ -0,0 +1,101 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef PIPELINE_EXECUTOR_H
+#define PIPELINE_EXECUTOR_H
+
+#include "Network.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief Streams samples through a network with consecutive layer groups on different threads.
+     *
+     * The layers are split into `numStages` contiguous groups of roughly equal weight
+     * count. Each group runs on its own thread, and bounded lock-free SPSC queues link
+     * neighbouring groups. While sample k is in group 2, sample k+1 can already be in
+     * group 1. This suits deep, narrow models that serve a steady stream: their layers are
+     * too small to split across cores, but there are enough of them to overlap.
+     *
+     * Outputs are bit-identical to `Network::feedForward` with the same weights.
+     *
+     * Usage:
+     *
+     * ```
+     * ML::PipelineExecutor pipeline (network, 4);
+     *
+     * // any thread
+     * std::vector<double> result = pipeline.submit ({0.5, 1.0}).get();
+     * ```
+     */
+    class PipelineExecutor
+    {
+    public:
+        /**
+         * @brief Serve a copy of the network's current weights.
+         *
+         * @param numStages Threads to spread the layers over; 0 uses one per layer, up to the number of cores.
+         * @param queueCapacity Samples each link can hold before `submit` has to wait.
+         */
+        explicit PipelineExecutor (const Network& network, unsigned numStages = 0, std::size_t queueCapacity = 64);
+
+        /**
+         * @brief Finishes every submitted sample, then stops the stages.
+         */
+        ~PipelineExecutor();
+
+        PipelineExecutor (const PipelineExecutor&) = delete;
+        PipelineExecutor& operator= (const PipelineExecutor&) = delete;
+
+        /**
+         * @brief Queue one sample, waiting while the first link is full. Safe to call from
+         * any thread. The future throws std::invalid_argument if the input does not match
+         * the model's input layer.
+         */
+        std::future<std::vector<double>> submit (std::vector<double> inputVals);
+
+        std::size_t getNumStages() const { return stages.size(); }
+
+        // Index of the first layer (counting the input layer as 0) each stage computes
+        std::vector<std::size_t> getStageBoundaries() const;
+
+    private:
+        struct Job
+        {
+            std::vector<double> activations;  // output of the last layer computed, bias included
+            std::promise<std::vector<double>> result;
+        };
+
+        struct Stage
+        {
+            std::size_t firstLayer;  // computes layers [firstLayer, lastLayer)
+            std::size_t lastLayer;
+            std::unique_ptr<SpscQueue<std::unique_ptr<Job>>> input;
+            std::atomic<bool> finished { false };
+            std::thread thread;
+        };
+
+        void run (std::size_t stageNum);
+
+        std::vector<unsigned> topology;
+        std::vector<double> weights;
+        std::vector<std::size_t> weightOffsets;
+
+        std::vector<std::unique_ptr<Stage>> stages;
+        std::mutex submitMutex;  // the first queue takes one producer at a time
+        std::atomic<bool> stopping { false };
+    };
+}
+
+#endif // PIPELINE_EXECUTOR_H
@@ -0,0 +1,84 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace ML
+{
+    /**
+     * @brief Small, fast xoshiro256** generator with no shared state.
+     *
+     * A generator is identified by a seed and a stream number. Distinct streams of the
+     * same seed are statistically independent, so work can be split into fixed chunks
+     * that each draw from their own stream and still produce the same numbers no matter
+     * how many threads run them.
+     */
+    class Random
+    {
+    public:
+        explicit Random (std::uint64_t seed, std::uint64_t stream = 0)
+        {
+            std::uint64_t x = seed ^ mix (stream + 0x632BE59BD9B4E019ull);
+            for (auto& word : state)
+            {
+                word = splitMix64 (x);
+            }
+        }
+
+        std::uint64_t next()
+        {
+            const std::uint64_t result = rotl (state[1] * 5, 7) * 9;
+            const std::uint64_t t = state[1] << 17;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl (state[3], 45);
+
+            return result;
+        }
+
+        // Uniform double in [0, 1)
+        double nextDouble() { return static_cast<double> (next() >> 11) * 0x1.0p-53; }
+
+        double uniform (double low, double high) { return low + (high - low) * nextDouble(); }
+
+        /**
+         * @brief A seed that differs between calls, even for calls made in the same instant
+         * from different threads.
+         */
+        static std::uint64_t makeSeed()
+        {
+            static std::atomic<std::uint64_t> counter { 0 };
+            const auto now = static_cast<std::uint64_t> (std::chrono::high_resolution_clock::now().time_since_epoch().count());
+            return mix (now ^ mix (counter.fetch_add (1, std::memory_order_relaxed)));
+        }
+
+    private:
+        static std::uint64_t rotl (std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        static std::uint64_t mix (std::uint64_t z)
+        {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        static std::uint64_t splitMix64 (std::uint64_t& x) { return mix (x += 0x9E3779B97F4A7C15ull); }
+
+        std::uint64_t state[4];
+    };
+}
+
+#endif // RANDOM_H
@@ -0,0 +1,199 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "Network.h"
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief An immutable copy of a network's weights that can be evaluated from any thread.
+     */
+    class WeightSnapshot
+    {
+    public:
+        WeightSnapshot() = default;
+        WeightSnapshot (std::vector<unsigned> topology, std::vector<double> weights, std::uint64_t version = 0)
+            : topology (std::move (topology)), weights (std::move (weights)), version (version)
+        {
+        }
+
+        const std::vector<unsigned>& getTopology() const { return topology; }
+        const std::vector<double>& getWeights() const { return weights; }
+        std::uint64_t getVersion() const { return version; }
+
+        // Returns an empty vector when the input size does not match the topology
+        std::vector<double> feedForward (const std::vector<double>& inputVals) const
+        {
+            if (topology.empty() || inputVals.size() != topology.front())
+            {
+                std::cerr << "Error: Snapshot expects " << (topology.empty() ? 0u : topology.front())
+                          << " inputs but got " << inputVals.size() << "\n";
+                return {};
+            }
+
+            std::vector<double> resultVals (topology.back());
+            feedForward (inputVals.data(), resultVals.data());
+            return resultVals;
+        }
+
+        void feedForward (const double* inputVals, double* resultVals) const
+        {
+            Network::feedForward (topology, weights.data(), inputVals, resultVals);
+        }
+
+        void feedForwardBatch (const double* inputVals, std::size_t batchSize, double* resultVals) const
+        {
+            Network::feedForwardBatch (topology, weights.data(), inputVals, batchSize, resultVals);
+        }
+
+    private:
+        friend class SnapshotPublisher;
+
+        std::vector<unsigned> topology;
+        std::vector<double> weights;
+        std::uint64_t version = 0;
+    };
+
+    /**
+     * @brief Publishes weight snapshots from a trainer to any number of concurrent readers.
+     *
+     * The trainer calls `publish` whenever it wants readers to see new weights; readers call
+     * `acquire` and evaluate the returned snapshot for as long as they hold the guard. The
+     * current snapshot is swapped in with a single atomic exchange, so readers never wait on
+     * the trainer and never see a half-written set of weights.
+     *
+     * Old snapshots are reclaimed epoch-style: every reader announces the epoch it entered in
+     * a slot, and a retired snapshot is recycled only once no reader from its epoch or earlier
+     * is still active. Recycled snapshots are reused by later publishes, so steady-state
+     * publishing copies weights without allocating.
+     *
+     * Usage:
+     *
+     * ```
+     * ML::SnapshotPublisher publisher;
+     *
+     * // trainer thread
+     * network.backPropagate (targets);
+     * publisher.publish (network);
+     *
+     * // reader threads
+     * auto snapshot = publisher.acquire();
+     * if (snapshot)
+     *     auto result = snapshot->feedForward (inputs);
+     * ```
+     */
+    class SnapshotPublisher
+    {
+    public:
+        /**
+         * @brief Guard that keeps one snapshot alive while it is being read.
+         */
+        class ReadGuard
+        {
+        public:
+            ReadGuard (ReadGuard&& other) noexcept
+                : slot (std::exchange (other.slot, nullptr)), snapshot (std::exchange (other.snapshot, nullptr))
+            {
+            }
+
+            ReadGuard& operator= (ReadGuard&& other) noexcept
+            {
+                release();
+                slot = std::exchange (other.slot, nullptr);
+                snapshot = std::exchange (other.snapshot, nullptr);
+                return *this;
+            }
+
+            ReadGuard (const ReadGuard&) = delete;
+            ReadGuard& operator= (const ReadGuard&) = delete;
+
+            ~ReadGuard() { release(); }
+
+            const WeightSnapshot* get() const { return snapshot; }
+            const WeightSnapshot* operator->() const { return snapshot; }
+            const WeightSnapshot& operator*() const { return *snapshot; }
+            explicit operator bool() const { return snapshot != nullptr; }
+
+        private:
+            friend class SnapshotPublisher;
+
+            ReadGuard (std::atomic<std::uint64_t>* slot, const WeightSnapshot* snapshot) : slot (slot), snapshot (snapshot) {}
+
+            void release()
+            {
+                if (slot != nullptr)
+                {
+                    slot->store (0, std::memory_order_release);
+                    slot = nullptr;
+                }
+                snapshot = nullptr;
+            }
+
+            std::atomic<std::uint64_t>* slot;
+            const WeightSnapshot* snapshot;
+        };
+
+        /**
+         * @param maxReaders The number of guards that may be held at once; further readers
+         *                   spin until a slot frees up.
+         */
+        explicit SnapshotPublisher (std::size_t maxReaders = 256);
+        ~SnapshotPublisher();
+
+        SnapshotPublisher (const SnapshotPublisher&) = delete;
+        SnapshotPublisher& operator= (const SnapshotPublisher&) = delete;
+
+        /**
+         * @brief Copy the network's current weights into a new snapshot and make it current.
+         *
+         * @return The version number of the published snapshot.
+         */
+        std::uint64_t publish (const Network& network);
+        std::uint64_t publish (const std::vector<unsigned>& topology, const double* weights);
+
+        /**
+         * @brief Grab the latest snapshot. Empty if nothing has been published yet.
+         */
+        ReadGuard acquire() const;
+
+        /**
+         * @brief Number of old snapshots still waiting for their readers to finish.
+         */
+        std::size_t getNumRetired() const;
+
+    private:
+        struct alignas (64) ReaderSlot
+        {
+            std::atomic<std::uint64_t> epoch { 0 }; // 0 when free
+        };
+
+        void reclaim();
+
+        std::unique_ptr<ReaderSlot[]> slots;
+        std::size_t numSlots;
+
+        std::atomic<WeightSnapshot*> current { nullptr };
+        std::atomic<std::uint64_t> epoch { 1 };
+
+        mutable std::mutex publishMutex; // serialises publishers; never taken by readers
+        std::vector<std::pair<std::uint64_t, std::unique_ptr<WeightSnapshot>>> retired;
+        std::vector<std::unique_ptr<WeightSnapshot>> spare;
+        std::uint64_t nextVersion = 1;
+    };
+}
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,110 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef SPARSE_H
+#define SPARSE_H
+
+#include "Network.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ML
+{
+    // Whether pruning ranks weights across the whole network or within each layer.
+    enum class PruneScope
+    {
+        Global,
+        PerLayer
+    };
+
+    /**
+     * @brief Zero the `sparsity` fraction (0..1) of weights with the smallest magnitude.
+     *
+     * The pruned weights are recorded in the network's weight mask, so they stay at zero
+     * through later `backPropagate` calls. Weights that are already masked count towards
+     * the target.
+     *
+     * @return The number of weights now pruned.
+     */
+    std::size_t pruneByMagnitude (Network& network, double sparsity, PruneScope scope = PruneScope::PerLayer);
+
+    /**
+     * @brief Zero (and mask) every weight whose magnitude is below `threshold`.
+     *
+     * @return The number of weights now pruned.
+     */
+    std::size_t pruneByThreshold (Network& network, double threshold);
+
+    /**
+     * @brief Gradually prune to `finalSparsity` in `numSteps` equal steps, calling `retrain`
+     * after each step so the remaining weights can recover.
+     */
+    void pruneAndRetrain (Network& network, double finalSparsity, unsigned numSteps,
+                          const std::function<void (Network&)>& retrain, PruneScope scope = PruneScope::PerLayer);
+
+    /**
+     * @brief Read-only copy of a network for inference, storing sparse layers in CSR form.
+     *
+     * Each layer whose density (fraction of non-zero weights) is below the break-even
+     * density is stored as compressed sparse rows, one row per destination neuron. Only its
+     * non-zero weights are visited. Denser layers keep the dense row-major kernel. Skipping
+     * zeros leaves every sum unchanged, so results match `Network::feedForward`.
+     *
+     * The default break-even density is measured once per process by timing both kernels
+     * on this machine (see `measureBreakEvenDensity`).
+     */
+    class SparseNetwork
+    {
+    public:
+        explicit SparseNetwork (const Network& network, double breakEvenDensity = getBreakEvenDensity());
+
+        std::vector<double> feedForward (const std::vector<double>& inputVals) const;
+
+        // Thread-safe; inputVals and resultVals are laid out like Network::feedForwardBatch.
+        void feedForward (const double* inputVals, double* resultVals) const;
+        void feedForwardBatch (const double* inputVals, std::size_t batchSize, double* resultVals) const;
+
+        const std::vector<unsigned>& getTopology() const { return topology; }
+        bool isLayerSparse (std::size_t layerNum) const { return layers[layerNum].sparse; }
+        double getLayerDensity (std::size_t layerNum) const { return layers[layerNum].density; }
+
+        /**
+         * @brief Density below which CSR beats the dense kernel, measured on first use.
+         */
+        static double getBreakEvenDensity();
+
+        /**
+         * @brief Time the dense and CSR kernels on a numInputs x numOutputs layer across a
+         * range of densities and return the highest density at which CSR is still faster.
+         */
+        static double measureBreakEvenDensity (unsigned numInputs = 256, unsigned numOutputs = 256);
+
+    private:
+        // Weights from layer l (numInputs neurons, bias included) into layer l + 1
+        struct SparseLayer
+        {
+            std::size_t numInputs = 0;
+            std::size_t numOutputs = 0;
+            double density = 1.0;
+            bool sparse = false;
+
+            std::vector<double> dense;          // row-major by source neuron, as in Network
+            std::vector<std::uint32_t> rowStart; // CSR by destination neuron
+            std::vector<std::uint32_t> columns;
+            std::vector<double> values;
+        };
+
+        static SparseLayer compress (const double* weights, std::size_t numInputs, std::size_t numOutputs,
+                                     double breakEvenDensity);
+
+        std::vector<unsigned> topology;
+        std::vector<SparseLayer> layers;
+    };
+}
+
+#endif // SPARSE_H
@@ -0,0 +1,100 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+     *
+     * A ring buffer whose capacity is rounded up to a power of two. The producer owns the
+     * tail index and the consumer owns the head index; each keeps a private copy of the
+     * other's index and re-reads the shared one only when the ring looks full or empty.
+     * The two indices sit on separate cache lines so the threads do not false-share.
+     */
+    template <typename T>
+    class SpscQueue
+    {
+    public:
+        explicit SpscQueue (std::size_t capacity)
+        {
+            std::size_t size = 2;
+            while (size < capacity)
+            {
+                size *= 2;
+            }
+            slots.resize (size);
+            mask = size - 1;
+        }
+
+        SpscQueue (const SpscQueue&) = delete;
+        SpscQueue& operator= (const SpscQueue&) = delete;
+
+        /**
+         * @brief Producer only. Returns false (leaving value untouched) if the queue is full.
+         */
+        bool tryPush (T& value)
+        {
+            const std::size_t tailIndex = producer.index.load (std::memory_order_relaxed);
+            if (tailIndex - producer.cachedOther == slots.size())
+            {
+                producer.cachedOther = consumer.index.load (std::memory_order_acquire);
+                if (tailIndex - producer.cachedOther == slots.size())
+                {
+                    return false;
+                }
+            }
+
+            slots[tailIndex & mask] = std::move (value);
+            producer.index.store (tailIndex + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Consumer only. Returns false if the queue is empty.
+         */
+        bool tryPop (T& value)
+        {
+            const std::size_t headIndex = consumer.index.load (std::memory_order_relaxed);
+            if (headIndex == consumer.cachedOther)
+            {
+                consumer.cachedOther = producer.index.load (std::memory_order_acquire);
+                if (headIndex == consumer.cachedOther)
+                {
+                    return false;
+                }
+            }
+
+            value = std::move (slots[headIndex & mask]);
+            consumer.index.store (headIndex + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::size_t capacity() const { return slots.size(); }
+
+    private:
+        struct alignas (64) Side
+        {
+            std::atomic<std::size_t> index { 0 };
+            std::size_t cachedOther = 0;  // last seen value of the other side's index
+        };
+
+        std::vector<T> slots;
+        std::size_t mask = 0;
+        Side producer;  // tail
+        Side consumer;  // head
+    };
+}
+
+#endif // SPSC_QUEUE_H
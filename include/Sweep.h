@@ -0,0 +1,100 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "Evaluate.h"
+#include "Perceptron.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ML
+{
+    /**
+     * @brief One model to train in a sweep.
+     *
+     * Training stops at the first of: the epoch error (the mean of
+     * `Network::getRecentAverageError` over the epoch's samples) reaching `targetError`,
+     * `patience` epochs passing without it improving by `minImprovement`, or `maxEpochs`.
+     * A patience of 0 disables the plateau check.
+     */
+    struct SweepConfig
+    {
+        std::vector<unsigned> topology;
+        WeightInit init = WeightInit::Uniform;
+        std::uint64_t seed = 0;
+        double learningRate = Neuron::eta;
+        double momentum = Neuron::alpha;
+        unsigned maxEpochs = 10000;
+        double targetError = 0.01;
+        unsigned patience = 0;
+        double minImprovement = 1e-6;
+    };
+
+    enum class SweepStatus
+    {
+        Converged,  // reached targetError
+        Plateaued,  // stopped by the patience check
+        MaxEpochs   // ran every epoch without converging
+    };
+
+    struct SweepResult
+    {
+        std::size_t configIndex = 0;
+        SweepConfig config;
+        SweepStatus status = SweepStatus::MaxEpochs;
+        unsigned epochs = 0;
+        double finalError = 0.0;
+        double bestError = 0.0;
+        double seconds = 0.0;
+        std::vector<double> weights;  // trained weights, in getWeights() order
+    };
+
+    /**
+     * @brief Every combination of the given topologies, initialisation schemes and seeds,
+     * with the remaining settings copied from `base`.
+     */
+    std::vector<SweepConfig> makeSweepGrid (const std::vector<std::vector<unsigned>>& topologies,
+                                            const std::vector<WeightInit>& inits,
+                                            const std::vector<std::uint64_t>& seeds,
+                                            const SweepConfig& base = SweepConfig());
+
+    /**
+     * @brief As above, also crossed with every (learning rate, momentum) pair.
+     */
+    std::vector<SweepConfig> makeSweepGrid (const std::vector<std::vector<unsigned>>& topologies,
+                                            const std::vector<WeightInit>& inits,
+                                            const std::vector<std::uint64_t>& seeds,
+                                            const std::vector<double>& learningRates,
+                                            const std::vector<double>& momenta,
+                                            const SweepConfig& base = SweepConfig());
+
+    /**
+     * @brief Train one Perceptron per config on the shared dataset, spread across threads.
+     *
+     * Each model trains on its own thread against the same read-only dataset, visiting the
+     * samples in order every epoch. Results depend only on each config, never on the thread
+     * count or scheduling. The most expensive configs start first so that stragglers do not
+     * hold up the end of the sweep. Pass 0 threads to use every core.
+     *
+     * @return One result per config, in config order; empty (with an error on cerr) if a
+     * config's topology does not match the dataset.
+     */
+    std::vector<SweepResult> runSweep (const std::vector<SweepConfig>& configs, const std::vector<Sample>& dataset,
+                                       unsigned numThreads = 0);
+
+    /**
+     * @brief Format results as a fixed-width table, one row per result, in the given order.
+     */
+    std::string formatSweepTable (const std::vector<SweepResult>& results);
+
+    const char* toString (SweepStatus status);
+}
+
+#endif // SWEEP_H
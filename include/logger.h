@@ -1,15 +1,246 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "SpscQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include <iomanip>
 #include <ctime>
 
+// Highest level compiled in: 0 NONE, 1 ERROR, 2 INFO, 3 DEBUG. Calls above it, made
+// through the LOGGER_* macros below, compile to nothing, arguments included.
+#ifndef LOGGER_MAX_VERBOSITY
+#define LOGGER_MAX_VERBOSITY 3
+#endif
+
+#define LOGGER_LOG_IF_(logger, level, call) \
+    do { if constexpr (LoggerNS::Logger::isCompiledIn (level)) { if ((logger).isEnabled (level)) { (logger).call; } } } while (0)
+
+#define LOGGER_ERROR(logger, message) LOGGER_LOG_IF_ (logger, LoggerNS::Logger::VerbosityLevel::ERROR, logError (message))
+#define LOGGER_INFO(logger, message) LOGGER_LOG_IF_ (logger, LoggerNS::Logger::VerbosityLevel::INFO, logInfo (message))
+#define LOGGER_DEBUG(logger, message) LOGGER_LOG_IF_ (logger, LoggerNS::Logger::VerbosityLevel::DEBUG, logDebug (message))
+#define LOGGER_RESULT(logger, label, expected, actual) \
+    LOGGER_LOG_IF_ (logger, LoggerNS::Logger::VerbosityLevel::INFO, logResult (label, expected, actual))
+
 namespace LoggerNS
 {
+    // One log line waiting to be written. Results keep their numbers and are only
+    // formatted on the writer thread.
+    struct LogRecord
+    {
+        std::chrono::system_clock::time_point time;
+        const char* level = "";
+        std::ostream* out = nullptr;
+        std::string message;
+        bool isResult = false;
+        std::vector<double> expected;
+        std::vector<double> actual;
+    };
+
+    inline std::string formatTime (std::time_t time)
+    {
+        char buffer[100];
+        std::tm timeinfo;
+
+#ifdef _WIN32
+        // Use localtime_s on Windows (thread-safe)
+        localtime_s(&timeinfo, &time);
+#else
+        // Use localtime_r on POSIX systems (thread-safe)
+        localtime_r(&time, &timeinfo);
+#endif
+
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &timeinfo);
+        return std::string(buffer);
+    }
+
+    inline void formatResult (std::ostream& oss, const std::string& label, const std::vector<double>& expected, const std::vector<double>& actual)
+    {
+        oss << label << " - Expected: [";
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            oss << std::fixed << std::setprecision(4) << expected[i];
+            if (i < expected.size() - 1)
+                oss << ", ";
+        }
+        oss << "], Actual: [";
+        for (size_t i = 0; i < actual.size(); ++i)
+        {
+            oss << std::fixed << std::setprecision(4) << actual[i];
+            if (i < actual.size() - 1)
+                oss << ", ";
+        }
+        oss << "]";
+    }
+
+    /**
+     * Writer behind every asynchronous Logger in the process.
+     *
+     * Each logging thread gets its own lock-free SPSC ring the first time it logs. A single
+     * background thread drains every ring, formats the records and writes them out, so a
+     * log call costs the logging thread a move into its ring and nothing more. When a ring
+     * is full the caller waits for the writer rather than dropping the record. Records from
+     * one thread come out in order; records from different threads may interleave.
+     */
+    class AsyncLogBackend
+    {
+    public:
+        static constexpr std::size_t ringCapacity = 1024;
+
+        static AsyncLogBackend& instance()
+        {
+            static AsyncLogBackend backend;
+            return backend;
+        }
+
+        void push (LogRecord&& record)
+        {
+            ML::SpscQueue<LogRecord>& ring = localRing();
+            while (!ring.tryPush (record))
+            {
+                wakeWriter();
+                std::this_thread::yield();
+            }
+        }
+
+        // Blocks until everything this thread logged before the call has been written.
+        void flush()
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            const std::uint64_t ticket = ++flushRequested;
+            wakeUp.notify_one();
+            flushed.wait (lock, [&] { return flushCompleted >= ticket; });
+        }
+
+        ~AsyncLogBackend()
+        {
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+                stopping = true;
+            }
+            wakeUp.notify_one();
+            writer.join();
+        }
+
+    private:
+        struct Ring
+        {
+            ML::SpscQueue<LogRecord> queue { ringCapacity };
+            std::atomic<bool> orphaned { false };  // its thread has exited
+        };
+
+        // Registers the calling thread's ring on first use and orphans it when the thread exits
+        struct RingHandle
+        {
+            std::shared_ptr<Ring> ring;
+            ~RingHandle() { if (ring) ring->orphaned.store (true, std::memory_order_release); }
+        };
+
+        AsyncLogBackend() : writer (&AsyncLogBackend::run, this) {}
+
+        ML::SpscQueue<LogRecord>& localRing()
+        {
+            thread_local RingHandle handle;
+            if (!handle.ring)
+            {
+                handle.ring = std::make_shared<Ring>();
+                std::lock_guard<std::mutex> lock (mutex);
+                rings.push_back (handle.ring);
+            }
+            return handle.ring->queue;
+        }
+
+        void wakeWriter()
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            wakeUp.notify_one();
+        }
+
+        void run()
+        {
+            std::vector<std::shared_ptr<Ring>> snapshot;
+            LogRecord record;
+
+            for (;;)
+            {
+                bool stop;
+                std::uint64_t ticket;
+                {
+                    std::unique_lock<std::mutex> lock (mutex);
+                    wakeUp.wait_for (lock, std::chrono::milliseconds (1), [&] { return stopping || flushRequested > flushCompleted; });
+                    stop = stopping;
+                    ticket = flushRequested;
+                    snapshot = rings;
+                }
+
+                std::vector<std::ostream*> written;
+                for (const auto& ring : snapshot)
+                {
+                    // Read before draining: once its thread has exited, a drained ring stays empty
+                    const bool orphaned = ring->orphaned.load (std::memory_order_acquire);
+                    while (ring->queue.tryPop (record))
+                    {
+                        write (record);
+                        if (std::find (written.begin(), written.end(), record.out) == written.end())
+                            written.push_back (record.out);
+                    }
+                    if (orphaned)
+                    {
+                        std::lock_guard<std::mutex> lock (mutex);
+                        rings.erase (std::remove (rings.begin(), rings.end(), ring), rings.end());
+                    }
+                }
+
+                for (std::ostream* out : written)
+                {
+                    out->flush();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock (mutex);
+                    flushCompleted = ticket;
+                }
+                flushed.notify_all();
+
+                if (stop)
+                {
+                    return;
+                }
+            }
+        }
+
+        static void write (const LogRecord& record)
+        {
+            std::ostringstream oss;
+            oss << "[" << formatTime (std::chrono::system_clock::to_time_t (record.time)) << "] " << record.level << ": ";
+            if (record.isResult)
+                formatResult (oss, record.message, record.expected, record.actual);
+            else
+                oss << record.message;
+            oss << '\n';
+            *record.out << oss.str();
+        }
+
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::condition_variable flushed;
+        std::vector<std::shared_ptr<Ring>> rings;
+        std::uint64_t flushRequested = 0;
+        std::uint64_t flushCompleted = 0;
+        bool stopping = false;
+        std::thread writer;
+    };
+
     class Logger
     {
     public:
@@ -21,11 +252,48 @@ namespace LoggerNS
             DEBUG
         };
 
-        Logger (VerbosityLevel verbosity = VerbosityLevel::INFO) : verbosity_(verbosity) {}
+        // Sync writes each line on the calling thread; Async hands it to AsyncLogBackend
+        enum class Mode
+        {
+            Sync,
+            Async
+        };
+
+        // In Async mode records hold on to `out` until the writer thread gets to them, so the
+        // stream must outlive every record still pending. The destructor waits for those
+        // this thread logged; records logged through this Logger from other threads must be
+        // flushed on those threads before the stream goes away.
+        Logger (VerbosityLevel verbosity = VerbosityLevel::INFO, Mode mode = Mode::Sync, std::ostream& out = std::cout)
+            : verbosity_(verbosity), mode_(mode), out_(&out)
+        {
+            if (mode_ == Mode::Async)
+            {
+                // Created first, so a static Logger is destroyed before the backend it flushes
+                AsyncLogBackend::instance();
+            }
+        }
+
+        ~Logger()
+        {
+            if (loggedAsync_)
+            {
+                AsyncLogBackend::instance().flush();
+            }
+        }
+
+        static constexpr bool isCompiledIn (VerbosityLevel level)
+        {
+            return static_cast<int> (level) <= LOGGER_MAX_VERBOSITY;
+        }
+
+        bool isEnabled (VerbosityLevel level) const
+        {
+            return isCompiledIn (level) && verbosity_ >= level;
+        }
 
         void logInfo (const std::string& message)
         {
-            if (verbosity_ >= VerbosityLevel::INFO)
+            if (isEnabled (VerbosityLevel::INFO))
             {
                 log ("INFO", message);
             }
@@ -33,7 +301,7 @@ namespace LoggerNS
 
         void logError (const std::string& message)
         {
-            if (verbosity_ >= VerbosityLevel::ERROR)
+            if (isEnabled (VerbosityLevel::ERROR))
             {
                 log ("ERROR", message);
             }
@@ -41,7 +309,7 @@ namespace LoggerNS
 
         void logDebug (const std::string& message)
         {
-            if (verbosity_ >= VerbosityLevel::DEBUG)
+            if (isEnabled (VerbosityLevel::DEBUG))
             {
                 log ("DEBUG", message);
             }
@@ -49,24 +317,20 @@ namespace LoggerNS
 
         void logResult (const std::string& label, const std::vector<double>& expected, const std::vector<double>& actual)
         {
-            if (verbosity_ >= VerbosityLevel::INFO)
+            if (isEnabled (VerbosityLevel::INFO))
             {
-                std::ostringstream oss;
-                oss << label << " - Expected: [";
-                for (size_t i = 0; i < expected.size(); ++i)
-                {
-                    oss << std::fixed << std::setprecision(4) << expected[i];
-                    if (i < expected.size() - 1)
-                        oss << ", ";
-                }
-                oss << "], Actual: [";
-                for (size_t i = 0; i < actual.size(); ++i)
+                if (mode_ == Mode::Async)
                 {
-                    oss << std::fixed << std::setprecision(4) << actual[i];
-                    if (i < actual.size() - 1)
-                        oss << ", ";
+                    LogRecord record = makeRecord ("INFO", label);
+                    record.isResult = true;
+                    record.expected = expected;
+                    record.actual = actual;
+                    pushAsync (std::move (record));
+                    return;
                 }
-                oss << "]";
+
+                std::ostringstream oss;
+                formatResult (oss, label, expected, actual);
                 logInfo (oss.str());
             }
         }
@@ -76,34 +340,60 @@ namespace LoggerNS
             verbosity_ = verbosity;
         }
 
+        void setMode (Mode mode)
+        {
+            mode_ = mode;
+        }
+
+        // Waits until every line this thread logged asynchronously has been written
+        void flush()
+        {
+            if (mode_ == Mode::Async)
+                AsyncLogBackend::instance().flush();
+            else
+                out_->flush();
+        }
+
     private:
         VerbosityLevel verbosity_;
+        Mode mode_;
+        std::ostream* out_;
+        bool loggedAsync_ = false;
 
-        void log (const std::string& level, const std::string& message)
+        void pushAsync (LogRecord&& record)
         {
+            loggedAsync_ = true;
+            AsyncLogBackend::instance().push (std::move (record));
+        }
+
+        LogRecord makeRecord (const char* level, const std::string& message) const
+        {
+            LogRecord record;
+            record.time = std::chrono::system_clock::now();
+            record.level = level;
+            record.out = out_;
+            record.message = message;
+            return record;
+        }
+
+        void log (const char* level, const std::string& message)
+        {
+            if (mode_ == Mode::Async)
+            {
+                pushAsync (makeRecord (level, message));
+                return;
+            }
+
             std::ostringstream oss;
             oss << "[" << getCurrentTime() << "] " << level << ": " << message;
-            std::cout << oss.str() << std::endl;
+            *out_ << oss.str() << std::endl;
         }
 
         std::string getCurrentTime()
         {
             std::time_t now;
             std::time(&now);
-
-            char buffer[100];
-            std::tm timeinfo;
-
-#ifdef _WIN32
-            // Use localtime_s on Windows (thread-safe)
-            localtime_s(&timeinfo, &now);
-#else
-            // Use localtime_r on POSIX systems (thread-safe)
-            localtime_r(&now, &timeinfo);
-#endif
-
-            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &timeinfo);
-            return std::string(buffer);
+            return formatTime (now);
         }
     };
 }
@@ -0,0 +1,385 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "AutoTune.h"
+#include "Network.h"
+#include "Parallel.h"
+#include "Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+namespace ML
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::uint64_t fnv1a (const std::string& text)
+        {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for (unsigned char c : text)
+            {
+                hash = (hash ^ c) * 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        std::string readCpuModel()
+        {
+            std::string model;
+#if defined(__APPLE__)
+            char brand[256] = {};
+            std::size_t size = sizeof (brand);
+            if (sysctlbyname ("machdep.cpu.brand_string", brand, &size, nullptr, 0) == 0)
+            {
+                model = brand;
+            }
+#elif defined(__unix__)
+            // x86 reports "model name"; many ARM kernels only "CPU implementer" and "CPU part"
+            std::ifstream cpuinfo ("/proc/cpuinfo");
+            std::string line, implementer, part;
+            while (model.empty() && std::getline (cpuinfo, line))
+            {
+                const std::size_t colon = line.find (':');
+                if (colon == std::string::npos)
+                {
+                    continue;
+                }
+                const std::string name = line.substr (0, line.find_last_not_of (" \t", colon - 1) + 1);
+                const std::string value = colon + 2 <= line.size() ? line.substr (colon + 2) : "";
+                if (name == "model name")
+                {
+                    model = value;
+                }
+                else if (name == "CPU implementer" && implementer.empty())
+                {
+                    implementer = value;
+                }
+                else if (name == "CPU part" && part.empty())
+                {
+                    part = value;
+                }
+            }
+            if (model.empty() && !implementer.empty())
+            {
+                model = "arm " + implementer + " " + part;
+            }
+#endif
+            // The model becomes part of a one-line key
+            model.erase (std::remove_if (model.begin(), model.end(), [] (char c) { return c == '\n' || c == '\r'; }), model.end());
+            return model.empty() ? "unknown" : model;
+        }
+
+        // Seconds per call of `run`, the fastest of several timings that together take
+        // about `budget` seconds. Each timing repeats the call enough to last a millisecond.
+        template <typename Function>
+        double secondsPerCall (Function&& run, double budget)
+        {
+            run(); // warm the caches and the scratch buffers
+
+            std::size_t repeats = 1;
+            for (;;)
+            {
+                const Clock::time_point start = Clock::now();
+                for (std::size_t r = 0; r < repeats; ++r)
+                {
+                    run();
+                }
+                const double seconds = std::chrono::duration<double> (Clock::now() - start).count();
+                if (seconds >= 1e-3 || repeats >= (1u << 20))
+                {
+                    break;
+                }
+                repeats *= 2;
+            }
+
+            double best = std::numeric_limits<double>::max();
+            const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration> (std::chrono::duration<double> (budget));
+            for (int round = 0; round < 3 || Clock::now() < deadline; ++round)
+            {
+                const Clock::time_point start = Clock::now();
+                for (std::size_t r = 0; r < repeats; ++r)
+                {
+                    run();
+                }
+                best = std::min (best, std::chrono::duration<double> (Clock::now() - start).count() / static_cast<double> (repeats));
+            }
+            return best;
+        }
+
+        std::size_t roundTo (std::size_t value, std::size_t multiple)
+        {
+            return std::max (multiple, value / multiple * multiple);
+        }
+
+        // The default blocking, smaller and larger tiles, and skipping gemm for the batch
+        std::vector<GemmBlocking> candidateBlockings (std::size_t batchSize)
+        {
+            const GemmBlocking& base = getDefaultGemmBlocking();
+            std::vector<GemmBlocking> candidates;
+
+            for (std::size_t kc : {base.kc, roundTo (base.kc / 2, 8), base.kc * 2})
+            {
+                for (std::size_t mc : {base.mc, roundTo (base.mc / 2, GemmBlocking::mr)})
+                {
+                    GemmBlocking b = base;
+                    b.kc = kc;
+                    b.mc = mc;
+                    candidates.push_back (b);
+                }
+            }
+
+            GemmBlocking gemvOnly = base;
+            gemvOnly.minPackedRows = batchSize + 1;
+            candidates.push_back (gemvOnly);
+            return candidates;
+        }
+    }
+
+    bool applyTuningPlan (const TuningPlan& plan)
+    {
+        return setGemmBlocking (plan.blocking);
+    }
+
+    const std::string& getCpuModel()
+    {
+        static const std::string model = readCpuModel();
+        return model;
+    }
+
+    AutoTuner::AutoTuner (std::string directory)
+        : cacheDirectory (directory.empty() ? defaultCacheDirectory() : std::move (directory))
+    {
+    }
+
+    std::string AutoTuner::defaultCacheDirectory()
+    {
+        if (const char* xdg = std::getenv ("XDG_CACHE_HOME"); xdg != nullptr && *xdg != '\0')
+        {
+            return std::string (xdg) + "/tinyml";
+        }
+        if (const char* home = std::getenv ("HOME"); home != nullptr && *home != '\0')
+        {
+            return std::string (home) + "/.cache/tinyml";
+        }
+        return ".tinyml-cache";
+    }
+
+    void AutoTuner::setOverride (const TuningPlan& plan)
+    {
+        overridePlan = std::make_unique<TuningPlan> (plan);
+    }
+
+    void AutoTuner::clearOverride()
+    {
+        overridePlan.reset();
+    }
+
+    std::string AutoTuner::getKey (const std::vector<unsigned>& topology, std::size_t batchSize) const
+    {
+        std::ostringstream key;
+        key << "cpu=" << getCpuModel() << ";cores=" << defaultThreadCount() << ";topology=";
+        for (std::size_t l = 0; l < topology.size(); ++l)
+        {
+            key << (l > 0 ? "-" : "") << topology[l];
+        }
+        key << ";batch=" << batchSize;
+        return key.str();
+    }
+
+    std::string AutoTuner::getPlanPath (const std::vector<unsigned>& topology, std::size_t batchSize) const
+    {
+        char name[32];
+        std::snprintf (name, sizeof (name), "%016llx.plan", static_cast<unsigned long long> (fnv1a (getKey (topology, batchSize))));
+        return cacheDirectory + "/" + name;
+    }
+
+    TuningPlan AutoTuner::tune (const std::vector<unsigned>& topology, std::size_t batchSize)
+    {
+        if (overridePlan != nullptr)
+        {
+            return *overridePlan;
+        }
+
+        batchSize = std::max<std::size_t> (batchSize, 1);
+        const std::string key = getKey (topology, batchSize);
+        const std::string path = getPlanPath (topology, batchSize);
+
+        TuningPlan plan;
+        if (loadPlan (path, key, plan))
+        {
+            return plan;
+        }
+
+        plan = measure (topology, batchSize);
+        ++measureCount;
+
+        // A cache that cannot be written only costs the next run another measurement
+        std::error_code error;
+        std::filesystem::create_directories (cacheDirectory, error);
+        savePlan (plan, key, path);
+        return plan;
+    }
+
+    TuningPlan AutoTuner::measure (const std::vector<unsigned>& topology, std::size_t batchSize) const
+    {
+        const Network network (topology, WeightInit::Xavier, 1);
+        const double* weights = network.getWeightData();
+
+        Random random (2);
+        std::vector<double> inputs (batchSize * topology.front());
+        for (double& x : inputs)
+        {
+            x = random.uniform (-1.0, 1.0);
+        }
+
+        const std::vector<GemmBlocking> blockings = candidateBlockings (batchSize);
+        const unsigned maxThreads = defaultThreadCount();
+        std::size_t numThreadCounts = 0;
+        for (unsigned t = 1; t <= maxThreads; t *= 2)
+        {
+            ++numThreadCounts;
+        }
+        const double slice = budgetSeconds / static_cast<double> (blockings.size() + numThreadCounts);
+
+        // Kernels and tiles on one thread first; gemm reads the blocking on every call
+        const GemmBlocking previous = getGemmBlocking();
+        std::vector<double> outputs (batchSize * topology.back());
+        auto runBatch = [&] { Network::feedForwardBatch (topology, weights, inputs.data(), batchSize, outputs.data()); };
+
+        TuningPlan plan;
+        double bestSeconds = std::numeric_limits<double>::max();
+        for (const GemmBlocking& blocking : blockings)
+        {
+            setGemmBlocking (blocking);
+            const double seconds = secondsPerCall (runBatch, slice);
+            if (seconds < bestSeconds)
+            {
+                bestSeconds = seconds;
+                plan.blocking = blocking;
+            }
+        }
+        plan.samplesPerSecond = static_cast<double> (batchSize) / bestSeconds;
+
+        // Then thread counts, each thread running its own batches the way evaluate does.
+        // More threads must win clearly, since they cost the rest of the program cores.
+        setGemmBlocking (plan.blocking);
+        const std::size_t batchesPerThread = 4;
+        for (unsigned numThreads = 2; numThreads <= maxThreads; numThreads *= 2)
+        {
+            const double seconds = secondsPerCall ([&]
+            {
+                parallelFor (numThreads, [&] (std::size_t)
+                {
+                    thread_local std::vector<double> threadOutputs;
+                    threadOutputs.resize (outputs.size());
+                    for (std::size_t b = 0; b < batchesPerThread; ++b)
+                    {
+                        Network::feedForwardBatch (topology, weights, inputs.data(), batchSize, threadOutputs.data());
+                    }
+                }, numThreads);
+            }, slice);
+
+            const double samplesPerSecond = static_cast<double> (numThreads * batchesPerThread * batchSize) / seconds;
+            if (samplesPerSecond > 1.1 * plan.samplesPerSecond)
+            {
+                plan.numThreads = numThreads;
+                plan.samplesPerSecond = samplesPerSecond;
+            }
+        }
+
+        setGemmBlocking (previous);
+        return plan;
+    }
+
+    bool AutoTuner::savePlan (const TuningPlan& plan, const std::string& key, const std::string& path)
+    {
+        // Written beside the target and renamed over it, so a process starting up never
+        // reads half a plan; the suffix keeps processes tuning at once apart
+        char suffix[32];
+        std::snprintf (suffix, sizeof (suffix), ".partial%016llx", static_cast<unsigned long long> (Random::makeSeed()));
+        const std::string temporaryPath = path + suffix;
+        {
+            std::ofstream file (temporaryPath, std::ios::trunc);
+            file.precision (std::numeric_limits<double>::max_digits10);
+            file << "key " << key << "\n"
+                 << "kc " << plan.blocking.kc << "\n"
+                 << "mc " << plan.blocking.mc << "\n"
+                 << "nc " << plan.blocking.nc << "\n"
+                 << "minPackedRows " << plan.blocking.minPackedRows << "\n"
+                 << "numThreads " << plan.numThreads << "\n"
+                 << "samplesPerSecond " << plan.samplesPerSecond << "\n";
+
+            if (!file)
+            {
+                std::cerr << "Error: Unable to write tuning plan " << temporaryPath << "\n";
+                std::remove (temporaryPath.c_str());
+                return false;
+            }
+        }
+
+        if (std::rename (temporaryPath.c_str(), path.c_str()) != 0)
+        {
+            std::cerr << "Error: Unable to move tuning plan into place at " << path << "\n";
+            std::remove (temporaryPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool AutoTuner::loadPlan (const std::string& path, const std::string& key, TuningPlan& plan)
+    {
+        std::ifstream file (path);
+        if (!file)
+        {
+            return false;
+        }
+
+        // A plan for another machine or topology that happens to share the file name is a miss
+        std::string line;
+        if (!std::getline (file, line) || line != "key " + key)
+        {
+            return false;
+        }
+
+        TuningPlan loaded;
+        unsigned found = 0;
+        std::string name;
+        while (file >> name)
+        {
+            if (name == "kc") { file >> loaded.blocking.kc; found |= 1; }
+            else if (name == "mc") { file >> loaded.blocking.mc; found |= 2; }
+            else if (name == "nc") { file >> loaded.blocking.nc; found |= 4; }
+            else if (name == "minPackedRows") { file >> loaded.blocking.minPackedRows; found |= 8; }
+            else if (name == "numThreads") { file >> loaded.numThreads; found |= 16; }
+            else if (name == "samplesPerSecond") { file >> loaded.samplesPerSecond; found |= 32; }
+            else { return false; }
+        }
+
+        const GemmBlocking& b = loaded.blocking;
+        if (file.bad() || !file.eof() || found != 63 || loaded.numThreads == 0 || b.kc == 0 || b.mc == 0
+            || b.mc % GemmBlocking::mr != 0 || b.nc == 0 || b.nc % GemmBlocking::nr != 0)
+        {
+            std::cerr << "Error: Ignoring malformed tuning plan " << path << "\n";
+            return false;
+        }
+
+        plan = loaded;
+        return true;
+    }
+}
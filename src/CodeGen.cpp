@@ -0,0 +1,104 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "CodeGen.h"
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace ML
+{
+    std::string generateModelHeader (const Network& network, const std::string& namespaceName)
+    {
+        const std::vector<unsigned>& topology = network.getTopology();
+        const double* weights = network.getWeightData();
+
+        std::ostringstream out;
+        out.precision (std::numeric_limits<double>::max_digits10); // literals round-trip exactly
+
+        out << "// Generated by TinyML from a trained model. Do not edit.\n"
+            << "// Topology:";
+        for (unsigned layerSize : topology)
+        {
+            out << " " << layerSize;
+        }
+        out << "\n\n"
+            << "#pragma once\n"
+            << "#include <cmath>\n\n"
+            << "namespace " << namespaceName << "\n"
+            << "{\n"
+            << "    constexpr unsigned numInputs = " << topology.front() << ";\n"
+            << "    constexpr unsigned numOutputs = " << topology.back() << ";\n\n";
+
+        // weightsN[i][n] connects neuron i of layer N to neuron n of layer N + 1; the last row is the bias neuron
+        for (std::size_t layerNum = 0; layerNum + 1 < topology.size(); ++layerNum)
+        {
+            const std::size_t rows = topology[layerNum] + 1;
+            const std::size_t cols = topology[layerNum + 1];
+
+            out << "    alignas (64) constexpr double weights" << layerNum << "[" << rows << "][" << cols << "] =\n"
+                << "    {\n";
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                out << "        { ";
+                for (std::size_t n = 0; n < cols; ++n)
+                {
+                    out << weights[i * cols + n] << (n + 1 < cols ? ", " : " ");
+                }
+                out << "}" << (i + 1 < rows ? "," : "") << "\n";
+            }
+            out << "    };\n\n";
+            weights += rows * cols;
+        }
+
+        out << "    inline void predict (const double* input, double* output)\n"
+            << "    {\n"
+            << "        alignas (64) double a0[" << topology.front() + 1 << "];\n"
+            << "        for (unsigned i = 0; i < " << topology.front() << "; ++i)\n"
+            << "            a0[i] = input[i];\n"
+            << "        a0[" << topology.front() << "] = " << network.layers.front().back().getOutputVal() << ";\n";
+
+        for (std::size_t layerNum = 1; layerNum < topology.size(); ++layerNum)
+        {
+            const std::size_t rows = topology[layerNum - 1] + 1;
+            const std::size_t cols = topology[layerNum];
+            const std::string prev = "a" + std::to_string (layerNum - 1);
+            const std::string cur = "a" + std::to_string (layerNum);
+
+            out << "\n"
+                << "        alignas (64) double " << cur << "[" << cols + 1 << "] = {};\n"
+                << "        for (unsigned i = 0; i < " << rows << "; ++i)\n"
+                << "            for (unsigned n = 0; n < " << cols << "; ++n)\n"
+                << "                " << cur << "[n] += " << prev << "[i] * weights" << layerNum - 1 << "[i][n];\n"
+                << "        for (unsigned n = 0; n < " << cols << "; ++n)\n"
+                << "            " << cur << "[n] = std::tanh (" << cur << "[n]);\n"
+                << "        " << cur << "[" << cols << "] = " << network.layers[layerNum].back().getOutputVal() << ";\n";
+        }
+
+        out << "\n"
+            << "        for (unsigned n = 0; n < " << topology.back() << "; ++n)\n"
+            << "            output[n] = a" << topology.size() - 1 << "[n];\n"
+            << "    }\n"
+            << "}\n";
+
+        return out.str();
+    }
+
+    bool exportModelHeader (const Network& network, const std::string& filename, const std::string& namespaceName)
+    {
+        std::ofstream outFile (filename);
+        if (!outFile)
+        {
+            std::cerr << "Error: Unable to open " << filename << " for writing\n";
+            return false;
+        }
+
+        outFile << generateModelHeader (network, namespaceName);
+        return static_cast<bool> (outFile);
+    }
+}
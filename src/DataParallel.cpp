@@ -0,0 +1,462 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "DataParallel.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define TINYML_HAS_PROCESS_GROUP 1
+#endif
+
+namespace ML
+{
+    struct ProcessGroup::Header
+    {
+        alignas (64) std::atomic<unsigned> arrived { 0 };
+        alignas (64) std::atomic<unsigned> sense { 0 };
+        alignas (64) std::atomic<unsigned> joined { 0 };  // ranks that have mapped the segment, plus startupAborted
+    };
+
+    // The segment is the header, then worldSize slots of count doubles, then the result
+    constexpr std::size_t segmentHeaderBytes = 192;
+    static_assert (std::atomic<unsigned>::is_always_lock_free, "barrier counters must be lock-free to live in shared memory");
+
+#ifdef TINYML_HAS_PROCESS_GROUP
+    namespace
+    {
+        // What rank 0 sends each process that connects
+        struct Welcome
+        {
+            std::uint32_t rank;
+            std::uint32_t worldSize;
+            std::uint64_t count;
+            char segmentName[64];
+        };
+
+        // What each process sends rank 0 first, so a mismatched one is turned away before it
+        // takes a rank
+        struct Request
+        {
+            std::uint32_t worldSize;
+            std::uint64_t count;
+        };
+
+        constexpr std::uint32_t rejectedRank = std::numeric_limits<std::uint32_t>::max();
+        constexpr unsigned startupAborted = 1u << 31;
+
+        // Held while binding or connecting, so a process never takes a host that has bound
+        // but not yet listened for a socket left behind by a crashed run
+        class SocketLock
+        {
+        public:
+            explicit SocketLock (const std::string& path) : fd (open (path.c_str(), O_CREAT | O_RDWR, 0600))
+            {
+                if (fd >= 0)
+                {
+                    flock (fd, LOCK_EX);
+                }
+            }
+
+            ~SocketLock()
+            {
+                if (fd >= 0)
+                {
+                    close (fd); // releases the lock
+                }
+            }
+
+        private:
+            int fd;
+        };
+
+        using Clock = std::chrono::steady_clock;
+
+        int remainingMilliseconds (Clock::time_point deadline)
+        {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds> (deadline - Clock::now()).count();
+            return static_cast<int> (std::max<long long> (left, 0));
+        }
+
+        bool fillAddress (const std::string& path, sockaddr_un& address)
+        {
+            std::memset (&address, 0, sizeof (address));
+            address.sun_family = AF_UNIX;
+            if (path.size() >= sizeof (address.sun_path))
+            {
+                return false;
+            }
+            std::memcpy (address.sun_path, path.c_str(), path.size() + 1);
+            return true;
+        }
+
+        std::size_t segmentBytes (unsigned worldSize, std::size_t count)
+        {
+            return segmentHeaderBytes + (static_cast<std::size_t> (worldSize) + 1) * count * sizeof (double);
+        }
+
+        // Startup barrier with a deadline: a rank that was handed out but never maps the
+        // segment must not leave the others waiting forever. Whoever times out first marks
+        // startup as aborted, so every rank either sees all of them arrive or sees the abort.
+        bool awaitEveryRank (std::atomic<unsigned>& joined, unsigned worldSize, Clock::time_point deadline)
+        {
+            unsigned state = joined.load (std::memory_order_acquire);
+            do
+            {
+                if ((state & startupAborted) != 0)
+                {
+                    return false;
+                }
+            } while (!joined.compare_exchange_weak (state, state + 1, std::memory_order_acq_rel));
+
+            Backoff backoff;
+            for (;;)
+            {
+                state = joined.load (std::memory_order_acquire);
+                if (state == worldSize)
+                {
+                    return true;
+                }
+                if ((state & startupAborted) != 0)
+                {
+                    return false;
+                }
+                if (Clock::now() >= deadline)
+                {
+                    if (joined.compare_exchange_strong (state, state | startupAborted, std::memory_order_acq_rel))
+                    {
+                        return false;
+                    }
+                    continue; // someone arrived meanwhile; look again
+                }
+                backoff.wait();
+            }
+        }
+    }
+
+    std::unique_ptr<ProcessGroup> ProcessGroup::join (const std::string& socketPath, unsigned worldSize, std::size_t count,
+                                                      double timeoutSeconds)
+    {
+        static_assert (sizeof (Header) <= segmentHeaderBytes, "header must fit before the slots");
+        const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds (static_cast<long long> (timeoutSeconds * 1000.0));
+
+        sockaddr_un address;
+        if (worldSize == 0 || !fillAddress (socketPath, address))
+        {
+            std::cerr << "Error: Invalid process group size or socket path " << socketPath << "\n";
+            return nullptr;
+        }
+
+        std::unique_ptr<ProcessGroup> group (new ProcessGroup());
+        group->worldSize = worldSize;
+        group->count = count;
+        group->mappingBytes = segmentBytes (worldSize, count);
+
+        // Bind to host, or connect to the host, retrying until one works. A socket file
+        // nobody listens on was left by a crashed run and is removed.
+        const std::string lockPath = socketPath + ".lock";
+        int listener = -1;
+        int connection = -1;
+        while (listener < 0 && connection < 0 && Clock::now() < deadline)
+        {
+            {
+                SocketLock lock (lockPath);
+                const int candidate = socket (AF_UNIX, SOCK_STREAM, 0);
+                if (candidate >= 0 && bind (candidate, reinterpret_cast<const sockaddr*> (&address), sizeof (address)) == 0)
+                {
+                    listen (candidate, static_cast<int> (worldSize));
+                    listener = candidate;
+                    break;
+                }
+                if (candidate >= 0)
+                {
+                    close (candidate);
+                }
+
+                const int joiner = socket (AF_UNIX, SOCK_STREAM, 0);
+                if (joiner >= 0 && connect (joiner, reinterpret_cast<const sockaddr*> (&address), sizeof (address)) == 0)
+                {
+                    connection = joiner;
+                    break;
+                }
+                const int connectError = errno;
+                if (joiner >= 0)
+                {
+                    close (joiner);
+                }
+                if (connectError == ECONNREFUSED)
+                {
+                    unlink (socketPath.c_str());
+                    continue;
+                }
+            }
+            std::this_thread::sleep_for (std::chrono::milliseconds (5));
+        }
+
+        if (listener >= 0)
+        {
+            // First to arrive: host the segment and hand out ranks
+            static std::atomic<unsigned> segmentCounter { 0 };
+            group->segmentName = "/tinyml-" + std::to_string (getpid()) + "-" + std::to_string (segmentCounter++);
+            const int fd = shm_open (group->segmentName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0 || ftruncate (fd, static_cast<off_t> (group->mappingBytes)) != 0)
+            {
+                std::cerr << "Error: Unable to create shared memory segment " << group->segmentName << "\n";
+                if (fd >= 0)
+                {
+                    close (fd);
+                    shm_unlink (group->segmentName.c_str());
+                }
+                close (listener);
+                unlink (socketPath.c_str());
+                return nullptr;
+            }
+            group->mapping = mmap (nullptr, group->mappingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close (fd);
+            if (group->mapping == MAP_FAILED)
+            {
+                std::cerr << "Error: Unable to map shared memory segment " << group->segmentName << "\n";
+                group->mapping = nullptr;
+                shm_unlink (group->segmentName.c_str());
+                group->segmentName.clear();
+                close (listener);
+                unlink (socketPath.c_str());
+                unlink (lockPath.c_str());
+                return nullptr;
+            }
+            new (group->mapping) Header();
+
+            bool complete = true;
+            for (unsigned nextRank = 1; nextRank < worldSize;)
+            {
+                pollfd waiting { listener, POLLIN, 0 };
+                const int arrival = poll (&waiting, 1, remainingMilliseconds (deadline)) > 0 ? accept (listener, nullptr, nullptr) : -1;
+                if (arrival < 0)
+                {
+                    complete = false;
+                    break;
+                }
+
+                Request request {};
+                pollfd incoming { arrival, POLLIN, 0 };
+                const bool received = poll (&incoming, 1, remainingMilliseconds (deadline)) > 0
+                                      && read (arrival, &request, sizeof (request)) == static_cast<ssize_t> (sizeof (request));
+                const bool accepted = received && request.worldSize == worldSize && request.count == count;
+
+                Welcome welcome {};
+                welcome.rank = accepted ? nextRank : rejectedRank;
+                welcome.worldSize = worldSize;
+                welcome.count = count;
+                std::strncpy (welcome.segmentName, group->segmentName.c_str(), sizeof (welcome.segmentName) - 1);
+                const bool sent = received && write (arrival, &welcome, sizeof (welcome)) == static_cast<ssize_t> (sizeof (welcome));
+                close (arrival);
+
+                // Only a rank that reached its process is used up
+                if (accepted && sent)
+                {
+                    ++nextRank;
+                }
+            }
+
+            close (listener);
+            unlink (socketPath.c_str());
+            unlink (lockPath.c_str());
+
+            if (!complete)
+            {
+                std::cerr << "Error: Process group at " << socketPath << " did not fill up in time\n";
+                shm_unlink (group->segmentName.c_str());
+                group->segmentName.clear();
+                return nullptr;
+            }
+        }
+        else
+        {
+            // Someone else hosts: say what we expect and wait for a rank
+            Welcome welcome {};
+            bool welcomed = false;
+            if (connection >= 0)
+            {
+                const Request request { worldSize, count };
+                pollfd waiting { connection, POLLIN, 0 };
+                welcomed = write (connection, &request, sizeof (request)) == static_cast<ssize_t> (sizeof (request))
+                           && poll (&waiting, 1, remainingMilliseconds (deadline)) > 0
+                           && read (connection, &welcome, sizeof (welcome)) == static_cast<ssize_t> (sizeof (welcome));
+                close (connection);
+            }
+
+            if (!welcomed || welcome.rank == rejectedRank || welcome.worldSize != worldSize || welcome.count != count)
+            {
+                std::cerr << "Error: Unable to join the process group at " << socketPath << "\n";
+                return nullptr;
+            }
+
+            group->rank = welcome.rank;
+            const int fd = shm_open (welcome.segmentName, O_RDWR, 0600);
+            group->mapping = fd >= 0 ? mmap (nullptr, group->mappingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+            if (fd >= 0)
+            {
+                close (fd);
+            }
+        }
+
+        if (group->mapping == MAP_FAILED)
+        {
+            group->mapping = nullptr;
+            std::cerr << "Error: Unable to map the process group's shared memory\n";
+            return nullptr;
+        }
+
+        group->header = static_cast<Header*> (group->mapping);
+        group->slots = reinterpret_cast<double*> (static_cast<char*> (group->mapping) + segmentHeaderBytes);
+        group->result = group->slots + static_cast<std::size_t> (worldSize) * count;
+
+        // Once everyone has mapped the segment its name is no longer needed, so nothing
+        // is left behind in /dev/shm even if a process later dies
+        if (!awaitEveryRank (group->header->joined, worldSize, deadline))
+        {
+            std::cerr << "Error: Not every rank of the process group at " << socketPath << " arrived in time\n";
+            return nullptr;
+        }
+        if (group->rank == 0)
+        {
+            shm_unlink (group->segmentName.c_str());
+            group->segmentName.clear();
+        }
+
+        return group;
+    }
+
+    ProcessGroup::~ProcessGroup()
+    {
+        if (mapping != nullptr)
+        {
+            munmap (mapping, mappingBytes);
+        }
+        if (!segmentName.empty())
+        {
+            shm_unlink (segmentName.c_str());
+        }
+    }
+#else
+    std::unique_ptr<ProcessGroup> ProcessGroup::join (const std::string& socketPath, unsigned, std::size_t, double)
+    {
+        std::cerr << "Error: Process groups need POSIX shared memory; cannot join " << socketPath << "\n";
+        return nullptr;
+    }
+
+    ProcessGroup::~ProcessGroup() = default;
+#endif
+
+    void ProcessGroup::barrier()
+    {
+        // Sense-reversing: the last to arrive resets the count and flips the shared sense
+        barrierSense ^= 1;
+        if (header->arrived.fetch_add (1, std::memory_order_acq_rel) == worldSize - 1)
+        {
+            header->arrived.store (0, std::memory_order_relaxed);
+            header->sense.store (barrierSense, std::memory_order_release);
+            return;
+        }
+
+        Backoff backoff;
+        while (header->sense.load (std::memory_order_acquire) != barrierSense)
+        {
+            backoff.wait();
+        }
+    }
+
+    void ProcessGroup::allReduceSum (double* values)
+    {
+        std::copy_n (values, count, slots + rank * count);
+        barrier();
+
+        // Reduce-scatter: this rank sums its slice over every slot, in rank order
+        const std::size_t begin = count * rank / worldSize;
+        const std::size_t end = count * (rank + 1) / worldSize;
+        std::copy (slots + begin, slots + end, result + begin);
+        for (unsigned r = 1; r < worldSize; ++r)
+        {
+            const double* slot = slots + r * count;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                result[i] += slot[i];
+            }
+        }
+        barrier();
+
+        // All-gather. The next call's first barrier keeps result intact until everyone has copied it.
+        std::copy_n (result, count, values);
+    }
+
+    double trainDataParallel (Network& network, ProcessGroup& group, const std::vector<Sample>& dataset,
+                              std::size_t batchSize, unsigned epochs)
+    {
+        const std::vector<unsigned>& topology = network.getTopology();
+        const std::size_t numWeights = network.getNumWeights();
+
+        bool matches = group.getCount() == dataParallelCount (network) && batchSize > 0;
+        for (const auto& [input, target] : dataset)
+        {
+            matches = matches && input.size() == topology.front() && target.size() == topology.back();
+        }
+        if (!matches)
+        {
+            std::cerr << "Error: Data-parallel training needs a group count of " << dataParallelCount (network)
+                      << ", a non-zero batch size and samples matching the topology\n";
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        std::vector<double> buffer (numWeights + 1);
+        double epochLoss = 0.0;
+
+        for (unsigned epoch = 0; epoch < epochs; ++epoch)
+        {
+            double lossSum = 0.0;
+
+            for (std::size_t batchStart = 0; batchStart < dataset.size(); batchStart += batchSize)
+            {
+                const std::size_t batchEnd = std::min (dataset.size(), batchStart + batchSize);
+                std::fill (buffer.begin(), buffer.end(), 0.0);
+
+                for (std::size_t i = batchStart + group.getRank(); i < batchEnd; i += group.getWorldSize())
+                {
+                    buffer[numWeights] += network.accumulateGradient (dataset[i].first.data(), dataset[i].second.data(), buffer.data());
+                }
+
+                group.allReduceSum (buffer.data());
+
+                const double scale = 1.0 / static_cast<double> (batchEnd - batchStart);
+                for (std::size_t w = 0; w < numWeights; ++w)
+                {
+                    buffer[w] *= scale;
+                }
+                network.applyGradient (buffer.data());
+                lossSum += buffer[numWeights];
+            }
+
+            epochLoss = dataset.empty() ? 0.0 : lossSum / static_cast<double> (dataset.size());
+        }
+
+        return epochLoss;
+    }
+}
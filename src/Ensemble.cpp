@@ -0,0 +1,246 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "Ensemble.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace ML
+{
+    Ensemble::Ensemble (const std::vector<unsigned>& topology, std::size_t numModels, WeightInit init, std::uint64_t seed)
+        : topology (topology),
+          numModels (numModels),
+          stride ((numModels + laneMultiple - 1) / laneMultiple * laneMultiple),
+          recentAverageErrors (numModels, 0.0)
+    {
+        assert (topology.size() >= 2 && numModels > 0);
+
+        weightOffsets = Network::layerWeightOffsets (topology);
+        activationOffsets.push_back (0);
+        for (std::size_t layerNum = 0; layerNum < topology.size(); ++layerNum)
+        {
+            activationOffsets.push_back (activationOffsets.back() + topology[layerNum] + 1);
+        }
+        numWeights = weightOffsets.back();
+        const std::size_t numNeurons = activationOffsets.back();
+
+        arena = Arena (2 * Arena::bytesFor<double> (numWeights * stride) + 2 * Arena::bytesFor<double> (numNeurons * stride));
+        weights = arena.allocate<double> (numWeights * stride);
+        deltaWeights = arena.allocate<double> (numWeights * stride);
+        values = arena.allocate<double> (numNeurons * stride);
+        gradientValues = arena.allocate<double> (numNeurons * stride);
+
+        // Padding lanes hold zero weights, so they compute zeros alongside the real models
+        std::fill_n (weights, numWeights * stride, 0.0);
+        std::fill_n (deltaWeights, numWeights * stride, 0.0);
+        std::fill_n (values, numNeurons * stride, 0.0);
+        std::fill_n (gradientValues, numNeurons * stride, 0.0);
+
+        for (std::size_t model = 0; model < numModels; ++model)
+        {
+            putWeights (model, Network (topology, init, seed + model).getWeights());
+        }
+    }
+
+    void Ensemble::feedForward (const std::vector<double>& inputVals)
+    {
+        assert (inputVals.size() == topology.front());
+
+        double* in = activations (0);
+        for (std::size_t i = 0; i < inputVals.size(); ++i)
+        {
+            std::fill_n (in + i * stride, stride, inputVals[i]);
+        }
+
+        for (std::size_t layerNum = 0; layerNum + 1 < topology.size(); ++layerNum)
+        {
+            const std::size_t numInputs = topology[layerNum] + 1; // bias neuron included, its output stays 0.0
+            const std::size_t numOutputs = topology[layerNum + 1];
+            const double* x = activations (layerNum);
+            const double* w = weights + weightOffsets[layerNum] * stride;
+            double* out = activations (layerNum + 1);
+
+            // Same accumulation order as Network's forwardLayer, one lane per model
+            std::fill_n (out, numOutputs * stride, 0.0);
+            for (std::size_t i = 0; i < numInputs; ++i)
+            {
+                const double* xi = x + i * stride;
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    const double* win = w + (i * numOutputs + n) * stride;
+                    double* sums = out + n * stride;
+                    for (std::size_t k = 0; k < stride; ++k)
+                    {
+                        sums[k] += xi[k] * win[k];
+                    }
+                }
+            }
+
+            for (std::size_t k = 0; k < numOutputs * stride; ++k)
+            {
+                out[k] = Neuron::transferFunction (out[k]);
+            }
+        }
+    }
+
+    void Ensemble::backPropagate (const std::vector<double>& targetVals)
+    {
+        const std::size_t numLayers = topology.size();
+        const std::size_t numOutputs = topology.back();
+        assert (targetVals.size() == numOutputs);
+
+        // RMS error per model, as Network reports it
+        const double* outputVals = activations (numLayers - 1);
+        double* outputGradients = gradients (numLayers - 1);
+        for (std::size_t model = 0; model < numModels; ++model)
+        {
+            double error = 0.0;
+            for (std::size_t n = 0; n < numOutputs; ++n)
+            {
+                const double delta = targetVals[n] - outputVals[n * stride + model];
+                error += delta * delta;
+            }
+            recentAverageErrors[model] = std::sqrt (error / numOutputs);
+        }
+
+        for (std::size_t n = 0; n < numOutputs; ++n)
+        {
+            const double* o = outputVals + n * stride;
+            double* g = outputGradients + n * stride;
+            for (std::size_t k = 0; k < stride; ++k)
+            {
+                g[k] = (targetVals[n] - o[k]) * Neuron::transferFunctionDerivative (o[k]);
+            }
+        }
+
+        // Hidden layer gradients
+        for (std::size_t layerNum = numLayers - 2; layerNum > 0; --layerNum)
+        {
+            const std::size_t numNeurons = topology[layerNum] + 1;
+            const std::size_t numNext = topology[layerNum + 1];
+            const double* w = weights + weightOffsets[layerNum] * stride;
+            const double* nextGradients = gradients (layerNum + 1);
+            const double* hiddenVals = activations (layerNum);
+            double* hiddenGradients = gradients (layerNum);
+
+            for (std::size_t i = 0; i < numNeurons; ++i)
+            {
+                double* g = hiddenGradients + i * stride;
+                std::fill_n (g, stride, 0.0);
+                for (std::size_t n = 0; n < numNext; ++n)
+                {
+                    const double* win = w + (i * numNext + n) * stride;
+                    const double* gn = nextGradients + n * stride;
+                    for (std::size_t k = 0; k < stride; ++k)
+                    {
+                        g[k] += win[k] * gn[k];
+                    }
+                }
+
+                const double* v = hiddenVals + i * stride;
+                for (std::size_t k = 0; k < stride; ++k)
+                {
+                    g[k] *= Neuron::transferFunctionDerivative (v[k]);
+                }
+            }
+        }
+
+        // Weight updates, output layer first
+        thread_local std::vector<double> scaledOutput;
+        scaledOutput.resize (stride);
+
+        for (std::size_t layerNum = numLayers - 1; layerNum > 0; --layerNum)
+        {
+            const std::size_t numPrev = topology[layerNum - 1] + 1;
+            const std::size_t numNeurons = topology[layerNum];
+            const double* prevVals = activations (layerNum - 1);
+            const double* layerGradients = gradients (layerNum);
+            double* w = weights + weightOffsets[layerNum - 1] * stride;
+            double* d = deltaWeights + weightOffsets[layerNum - 1] * stride;
+
+            for (std::size_t i = 0; i < numPrev; ++i)
+            {
+                for (std::size_t k = 0; k < stride; ++k)
+                {
+                    scaledOutput[k] = Neuron::eta * prevVals[i * stride + k];
+                }
+
+                for (std::size_t n = 0; n < numNeurons; ++n)
+                {
+                    double* win = w + (i * numNeurons + n) * stride;
+                    double* din = d + (i * numNeurons + n) * stride;
+                    const double* g = layerGradients + n * stride;
+                    for (std::size_t k = 0; k < stride; ++k)
+                    {
+                        const double newDeltaWeight = scaledOutput[k] * g[k] + Neuron::alpha * din[k];
+                        din[k] = newDeltaWeight;
+                        win[k] += newDeltaWeight;
+                    }
+                }
+            }
+        }
+    }
+
+    void Ensemble::getResults (std::size_t model, std::vector<double>& resultVals) const
+    {
+        assert (model < numModels);
+        const double* outputVals = activations (topology.size() - 1);
+
+        resultVals.resize (topology.back());
+        for (std::size_t n = 0; n < resultVals.size(); ++n)
+        {
+            resultVals[n] = outputVals[n * stride + model];
+        }
+    }
+
+    void Ensemble::getMeanAndVariance (std::vector<double>& mean, std::vector<double>& variance) const
+    {
+        const double* outputVals = activations (topology.size() - 1);
+        mean.assign (topology.back(), 0.0);
+        variance.assign (topology.back(), 0.0);
+
+        for (std::size_t n = 0; n < mean.size(); ++n)
+        {
+            const double* o = outputVals + n * stride;
+            double sum = 0.0;
+            for (std::size_t k = 0; k < numModels; ++k)
+            {
+                sum += o[k];
+            }
+            mean[n] = sum / numModels;
+
+            double squares = 0.0;
+            for (std::size_t k = 0; k < numModels; ++k)
+            {
+                squares += (o[k] - mean[n]) * (o[k] - mean[n]);
+            }
+            variance[n] = squares / numModels;
+        }
+    }
+
+    std::vector<double> Ensemble::getWeights (std::size_t model) const
+    {
+        assert (model < numModels);
+        std::vector<double> modelWeights (numWeights);
+        for (std::size_t w = 0; w < numWeights; ++w)
+        {
+            modelWeights[w] = weights[w * stride + model];
+        }
+        return modelWeights;
+    }
+
+    void Ensemble::putWeights (std::size_t model, const std::vector<double>& newWeights)
+    {
+        assert (model < numModels);
+        const std::size_t count = std::min (newWeights.size(), numWeights);
+        for (std::size_t w = 0; w < count; ++w)
+        {
+            weights[w * stride + model] = newWeights[w];
+        }
+    }
+}
@@ -0,0 +1,193 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "Evaluate.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+
+namespace ML
+{
+    namespace
+    {
+        // Chunks are a fixed number of samples so the reduction order never depends on threads
+        constexpr std::size_t batchesPerChunk = 16;
+        constexpr double probabilityFloor = 1e-15;
+
+        struct Partial
+        {
+            std::size_t correct = 0;
+            double squaredError = 0.0;
+            double absoluteError = 0.0;
+            double logLoss = 0.0;
+        };
+
+        std::size_t classOf (const double* values, std::size_t numOutputs)
+        {
+            if (numOutputs == 1)
+            {
+                return values[0] >= 0.5 ? 1 : 0;
+            }
+            return static_cast<std::size_t> (std::max_element (values, values + numOutputs) - values);
+        }
+
+        double clampProbability (double p)
+        {
+            return std::clamp (p, probabilityFloor, 1.0 - probabilityFloor);
+        }
+    }
+
+    EvaluationResult evaluate (const Network& network, const std::vector<Sample>& dataset, Metric metrics,
+                               unsigned numThreads, std::size_t batchSize)
+    {
+        const std::vector<unsigned>& topology = network.getTopology();
+        const std::size_t numInputs = topology.front();
+        const std::size_t numOutputs = topology.back();
+
+        for (std::size_t i = 0; i < dataset.size(); ++i)
+        {
+            if (dataset[i].first.size() != numInputs || dataset[i].second.size() != numOutputs)
+            {
+                std::cerr << "Error: Sample " << i << " does not match the network's input and output sizes\n";
+                return {};
+            }
+        }
+
+        const bool wantAccuracy = hasMetric (metrics, Metric::Accuracy);
+        const bool wantRmse = hasMetric (metrics, Metric::RMSE);
+        const bool wantMae = hasMetric (metrics, Metric::MAE);
+        const bool wantLogLoss = hasMetric (metrics, Metric::LogLoss);
+        const bool wantConfusion = hasMetric (metrics, Metric::ConfusionMatrix);
+
+        EvaluationResult result;
+        result.numSamples = dataset.size();
+        result.numClasses = numOutputs == 1 ? 2 : numOutputs;
+
+        batchSize = std::max<std::size_t> (batchSize, 1);
+        const std::size_t chunkSize = batchSize * batchesPerChunk;
+        const std::size_t numChunks = (dataset.size() + chunkSize - 1) / chunkSize;
+
+        if (numThreads == 0)
+        {
+            numThreads = defaultThreadCount();
+        }
+        numThreads = static_cast<unsigned> (std::max<std::size_t> (1, std::min<std::size_t> (numThreads, numChunks)));
+
+        const std::size_t confusionSize = wantConfusion ? result.numClasses * result.numClasses : 0;
+        std::vector<Partial> partials (numChunks);
+        std::vector<std::vector<std::size_t>> confusion (numThreads, std::vector<std::size_t> (confusionSize, 0));
+        std::atomic<std::size_t> nextChunk { 0 };
+        const double* weights = network.getWeightData();
+        const Loss loss = network.getLoss();
+
+        auto worker = [&] (std::size_t workerNum)
+        {
+            std::vector<double> inputs (batchSize * numInputs);
+            std::vector<double> outputs (batchSize * numOutputs);
+            std::vector<double> sums (batchSize * numOutputs);
+            std::vector<double> predictions (numOutputs);
+            std::vector<std::size_t>& counts = confusion[workerNum];
+
+            for (std::size_t c = nextChunk.fetch_add (1); c < numChunks; c = nextChunk.fetch_add (1))
+            {
+                Partial& partial = partials[c];
+                const std::size_t chunkEnd = std::min (dataset.size(), (c + 1) * chunkSize);
+
+                for (std::size_t start = c * chunkSize; start < chunkEnd; start += batchSize)
+                {
+                    const std::size_t count = std::min (batchSize, chunkEnd - start);
+                    for (std::size_t b = 0; b < count; ++b)
+                    {
+                        std::copy (dataset[start + b].first.begin(), dataset[start + b].first.end(), inputs.begin() + b * numInputs);
+                    }
+
+                    Network::feedForwardBatch (topology, weights, inputs.data(), count, outputs.data(), sums.data());
+
+                    for (std::size_t b = 0; b < count; ++b)
+                    {
+                        computePredictions (loss, numOutputs, outputs.data() + b * numOutputs, sums.data() + b * numOutputs,
+                                            predictions.data());
+                        const double* target = dataset[start + b].second.data();
+
+                        if (wantAccuracy || wantConfusion)
+                        {
+                            const std::size_t targetClass = classOf (target, numOutputs);
+                            const std::size_t predictedClass = classOf (predictions.data(), numOutputs);
+                            partial.correct += targetClass == predictedClass ? 1 : 0;
+                            if (wantConfusion)
+                            {
+                                ++counts[targetClass * result.numClasses + predictedClass];
+                            }
+                        }
+
+                        for (std::size_t n = 0; n < numOutputs && (wantRmse || wantMae); ++n)
+                        {
+                            const double delta = predictions[n] - target[n];
+                            partial.squaredError += delta * delta;
+                            partial.absoluteError += std::abs (delta);
+                        }
+
+                        if (wantLogLoss)
+                        {
+                            if (numOutputs == 1)
+                            {
+                                const double p = clampProbability (predictions[0]);
+                                partial.logLoss -= target[0] * std::log (p) + (1.0 - target[0]) * std::log (1.0 - p);
+                            }
+                            else
+                            {
+                                for (std::size_t n = 0; n < numOutputs; ++n)
+                                {
+                                    if (target[n] != 0.0)
+                                    {
+                                        partial.logLoss -= target[n] * std::log (clampProbability (predictions[n]));
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        parallelFor (numThreads, worker, numThreads);
+
+        result.confusionMatrix.assign (confusionSize, 0);
+        if (dataset.empty())
+        {
+            return result;
+        }
+
+        Partial total;
+        for (const Partial& partial : partials)
+        {
+            total.correct += partial.correct;
+            total.squaredError += partial.squaredError;
+            total.absoluteError += partial.absoluteError;
+            total.logLoss += partial.logLoss;
+        }
+
+        const double numSamples = static_cast<double> (dataset.size());
+        const double numValues = numSamples * static_cast<double> (numOutputs);
+        result.accuracy = wantAccuracy ? static_cast<double> (total.correct) / numSamples : 0.0;
+        result.rmse = wantRmse ? std::sqrt (total.squaredError / numValues) : 0.0;
+        result.mae = wantMae ? total.absoluteError / numValues : 0.0;
+        result.logLoss = wantLogLoss ? total.logLoss / numSamples : 0.0;
+
+        for (const auto& counts : confusion)
+        {
+            for (std::size_t i = 0; i < confusionSize; ++i)
+            {
+                result.confusionMatrix[i] += counts[i];
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,344 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "Gemm.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace ML
+{
+    namespace
+    {
+        constexpr std::size_t mr = GemmBlocking::mr;
+        constexpr std::size_t nr = GemmBlocking::nr;
+
+        std::size_t cacheSize (int name, std::size_t fallback)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            const long size = sysconf (name);
+            if (size > 0)
+            {
+                return static_cast<std::size_t> (size);
+            }
+#endif
+            (void) name;
+            return fallback;
+        }
+
+        struct AtomicBlocking
+        {
+            std::atomic<std::size_t> kc { 0 };
+            std::atomic<std::size_t> mc { 0 };
+            std::atomic<std::size_t> nc { 0 };
+            std::atomic<std::size_t> minPackedRows { 0 };
+        };
+
+        AtomicBlocking currentBlocking;
+        std::atomic<bool> blockingOverridden { false };
+
+        std::size_t roundDown (std::size_t value, std::size_t multiple, std::size_t minimum)
+        {
+            return std::max (minimum, value / multiple * multiple);
+        }
+
+        // Copy an mb x kb block of A into mr-row panels, column by column, padding the last panel with zeros
+        void packA (std::size_t mb, std::size_t kb, const double* a, std::size_t lda, double* packed)
+        {
+            for (std::size_t i0 = 0; i0 < mb; i0 += mr)
+            {
+                const std::size_t rows = std::min (mr, mb - i0);
+                for (std::size_t p = 0; p < kb; ++p)
+                {
+                    for (std::size_t r = 0; r < mr; ++r)
+                    {
+                        packed[p * mr + r] = r < rows ? a[(i0 + r) * lda + p] : 0.0;
+                    }
+                }
+                packed += mr * kb;
+            }
+        }
+
+        // Copy a kb x nb block of B into nr-column panels, row by row, padding the last panel with zeros
+        void packB (std::size_t kb, std::size_t nb, const double* b, std::size_t ldb, double* packed)
+        {
+            for (std::size_t j0 = 0; j0 < nb; j0 += nr)
+            {
+                const std::size_t cols = std::min (nr, nb - j0);
+                for (std::size_t p = 0; p < kb; ++p)
+                {
+                    const double* row = b + p * ldb + j0;
+                    for (std::size_t c = 0; c < nr; ++c)
+                    {
+                        packed[p * nr + c] = c < cols ? row[c] : 0.0;
+                    }
+                }
+                packed += nr * kb;
+            }
+        }
+
+        // C tile (rows x cols, at most mr x nr) += packed A panel * packed B panel, held in registers
+        void microKernel (std::size_t kb, const double* pa, const double* pb, double* c, std::size_t ldc,
+                          std::size_t rows, std::size_t cols)
+        {
+            double acc[mr][nr];
+            for (std::size_t r = 0; r < mr; ++r)
+            {
+                for (std::size_t j = 0; j < nr; ++j)
+                {
+                    acc[r][j] = r < rows && j < cols ? c[r * ldc + j] : 0.0;
+                }
+            }
+
+            for (std::size_t p = 0; p < kb; ++p)
+            {
+                const double* ap = pa + p * mr;
+                const double* bp = pb + p * nr;
+                for (std::size_t r = 0; r < mr; ++r)
+                {
+                    for (std::size_t j = 0; j < nr; ++j)
+                    {
+                        acc[r][j] += ap[r] * bp[j];
+                    }
+                }
+            }
+
+            for (std::size_t r = 0; r < rows; ++r)
+            {
+                for (std::size_t j = 0; j < cols; ++j)
+                {
+                    c[r * ldc + j] = acc[r][j];
+                }
+            }
+        }
+    }
+
+    const CacheSizes& getCacheSizes()
+    {
+        static const CacheSizes sizes = []
+        {
+            CacheSizes detected;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+            detected.l1 = cacheSize (_SC_LEVEL1_DCACHE_SIZE, detected.l1);
+            detected.l2 = cacheSize (_SC_LEVEL2_CACHE_SIZE, detected.l2);
+            detected.l3 = cacheSize (_SC_LEVEL3_CACHE_SIZE, detected.l3);
+#else
+            (void) cacheSize;
+#endif
+            return detected;
+        }();
+        return sizes;
+    }
+
+    const GemmBlocking& getDefaultGemmBlocking()
+    {
+        static const GemmBlocking blocking = []
+        {
+            const CacheSizes& caches = getCacheSizes();
+            GemmBlocking b;
+            b.kc = roundDown (caches.l1 / 2 / (sizeof (double) * (mr + nr)), 8, 32);
+            b.mc = roundDown (caches.l2 / 2 / (sizeof (double) * b.kc), mr, mr);
+            b.nc = roundDown (std::max (caches.l3, caches.l2) / 2 / (sizeof (double) * b.kc), nr, nr);
+            return b;
+        }();
+        return blocking;
+    }
+
+    GemmBlocking getGemmBlocking()
+    {
+        if (!blockingOverridden.load (std::memory_order_acquire))
+        {
+            return getDefaultGemmBlocking();
+        }
+
+        // A reader racing setGemmBlocking may mix old and new fields; every mix is valid
+        GemmBlocking b;
+        b.kc = currentBlocking.kc.load (std::memory_order_relaxed);
+        b.mc = currentBlocking.mc.load (std::memory_order_relaxed);
+        b.nc = currentBlocking.nc.load (std::memory_order_relaxed);
+        b.minPackedRows = currentBlocking.minPackedRows.load (std::memory_order_relaxed);
+        return b;
+    }
+
+    bool setGemmBlocking (const GemmBlocking& blocking)
+    {
+        if (blocking.kc == 0 || blocking.mc == 0 || blocking.mc % mr != 0 || blocking.nc == 0 || blocking.nc % nr != 0)
+        {
+            std::cerr << "Error: Gemm blocking needs kc > 0, mc a multiple of " << mr << " and nc a multiple of " << nr << "\n";
+            return false;
+        }
+
+        currentBlocking.kc.store (blocking.kc, std::memory_order_relaxed);
+        currentBlocking.mc.store (blocking.mc, std::memory_order_relaxed);
+        currentBlocking.nc.store (blocking.nc, std::memory_order_relaxed);
+        currentBlocking.minPackedRows.store (blocking.minPackedRows, std::memory_order_relaxed);
+        blockingOverridden.store (true, std::memory_order_release);
+        return true;
+    }
+
+    void resetGemmBlocking()
+    {
+        blockingOverridden.store (false, std::memory_order_release);
+    }
+
+    void gemm (std::size_t m, std::size_t n, std::size_t k, const double* a, std::size_t lda,
+               const double* b, std::size_t ldb, double beta, double* c, std::size_t ldc)
+    {
+        assert (beta == 0.0 || beta == 1.0);
+
+        if (beta == 0.0)
+        {
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                std::fill_n (c + i * ldc, n, 0.0);
+            }
+        }
+
+        if (m == 0 || n == 0 || k == 0)
+        {
+            return;
+        }
+
+        const GemmBlocking blocking = getGemmBlocking();
+        if (m < blocking.minPackedRows)
+        {
+            // Too few rows to repay packing B; each row of C is x * B, summed in the same order
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                gemvT (k, n, b, ldb, a + i * lda, beta, c + i * ldc);
+            }
+            return;
+        }
+
+        thread_local std::vector<double> packedA, packedB;
+
+        for (std::size_t jc = 0; jc < n; jc += blocking.nc)
+        {
+            const std::size_t nb = std::min (blocking.nc, n - jc);
+
+            // k blocks go in ascending order, so each element still sums its products in order
+            for (std::size_t pc = 0; pc < k; pc += blocking.kc)
+            {
+                const std::size_t kb = std::min (blocking.kc, k - pc);
+                packedB.resize ((nb + nr - 1) / nr * nr * kb);
+                packB (kb, nb, b + pc * ldb + jc, ldb, packedB.data());
+
+                for (std::size_t ic = 0; ic < m; ic += blocking.mc)
+                {
+                    const std::size_t mb = std::min (blocking.mc, m - ic);
+                    packedA.resize ((mb + mr - 1) / mr * mr * kb);
+                    packA (mb, kb, a + ic * lda + pc, lda, packedA.data());
+
+                    for (std::size_t jr = 0; jr < nb; jr += nr)
+                    {
+                        for (std::size_t ir = 0; ir < mb; ir += mr)
+                        {
+                            microKernel (kb, packedA.data() + ir * kb, packedB.data() + jr * kb,
+                                         c + (ic + ir) * ldc + jc + jr, ldc, std::min (mr, mb - ir), std::min (nr, nb - jr));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void gemv (std::size_t m, std::size_t n, const double* a, std::size_t lda, const double* x, double beta, double* y)
+    {
+        // Four rows at a time share each load of x
+        std::size_t i = 0;
+        for (; i + 4 <= m; i += 4)
+        {
+            const double* a0 = a + i * lda;
+            const double* a1 = a0 + lda;
+            const double* a2 = a1 + lda;
+            const double* a3 = a2 + lda;
+            double s0 = beta == 0.0 ? 0.0 : beta * y[i];
+            double s1 = beta == 0.0 ? 0.0 : beta * y[i + 1];
+            double s2 = beta == 0.0 ? 0.0 : beta * y[i + 2];
+            double s3 = beta == 0.0 ? 0.0 : beta * y[i + 3];
+
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                s0 += a0[j] * x[j];
+                s1 += a1[j] * x[j];
+                s2 += a2[j] * x[j];
+                s3 += a3[j] * x[j];
+            }
+
+            y[i] = s0;
+            y[i + 1] = s1;
+            y[i + 2] = s2;
+            y[i + 3] = s3;
+        }
+
+        for (; i < m; ++i)
+        {
+            const double* row = a + i * lda;
+            double sum = beta == 0.0 ? 0.0 : beta * y[i];
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                sum += row[j] * x[j];
+            }
+            y[i] = sum;
+        }
+    }
+
+    void gemvT (std::size_t m, std::size_t n, const double* a, std::size_t lda, const double* x, double beta, double* y)
+    {
+        if (beta == 0.0)
+        {
+            std::fill_n (y, n, 0.0);
+        }
+        else if (beta != 1.0)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                y[j] *= beta;
+            }
+        }
+
+        // Columns are tiled so a strip of y stays in L1 while four rows at a time stream past it
+        const std::size_t tile = std::max<std::size_t> (nr, getCacheSizes().l1 / 4 / sizeof (double));
+
+        for (std::size_t j0 = 0; j0 < n; j0 += tile)
+        {
+            const std::size_t nb = std::min (tile, n - j0);
+            double* yt = y + j0;
+
+            std::size_t i = 0;
+            for (; i + 4 <= m; i += 4)
+            {
+                const double* a0 = a + i * lda + j0;
+                const double* a1 = a0 + lda;
+                const double* a2 = a1 + lda;
+                const double* a3 = a2 + lda;
+                const double x0 = x[i], x1 = x[i + 1], x2 = x[i + 2], x3 = x[i + 3];
+
+                for (std::size_t j = 0; j < nb; ++j)
+                {
+                    yt[j] = (((yt[j] + x0 * a0[j]) + x1 * a1[j]) + x2 * a2[j]) + x3 * a3[j];
+                }
+            }
+
+            for (; i < m; ++i)
+            {
+                const double* row = a + i * lda + j0;
+                const double xi = x[i];
+                for (std::size_t j = 0; j < nb; ++j)
+                {
+                    yt[j] += xi * row[j];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,201 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "InferenceExecutor.h"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace ML
+{
+    InferenceExecutor::InferenceExecutor (const Network& network, std::size_t maxBatchSize,
+                                          std::chrono::microseconds maxWait, unsigned numWorkers)
+        : ownedWeights (std::make_unique<SnapshotPublisher>()), weights (ownedWeights.get()),
+          maxBatchSize (std::max<std::size_t> (maxBatchSize, 1)), maxWait (maxWait)
+    {
+        ownedWeights->publish (network);
+        start (numWorkers);
+    }
+
+    InferenceExecutor::InferenceExecutor (const SnapshotPublisher& weights, std::size_t maxBatchSize,
+                                          std::chrono::microseconds maxWait, unsigned numWorkers)
+        : weights (&weights), maxBatchSize (std::max<std::size_t> (maxBatchSize, 1)), maxWait (maxWait)
+    {
+        start (numWorkers);
+    }
+
+    void InferenceExecutor::start (unsigned numWorkers)
+    {
+        stats.batchSizes.assign (maxBatchSize + 1, 0);
+
+        for (unsigned w = 0; w < std::max (numWorkers, 1u); ++w)
+        {
+            workers.emplace_back (&InferenceExecutor::run, this);
+        }
+    }
+
+    InferenceExecutor::~InferenceExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock (queueMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    std::future<std::vector<double>> InferenceExecutor::submit (std::vector<double> inputVals)
+    {
+        Request request { std::move (inputVals), {}, Clock::now() };
+        std::future<std::vector<double>> result = request.result.get_future();
+
+        std::size_t queued;
+        {
+            std::lock_guard<std::mutex> lock (queueMutex);
+            queue.push_back (std::move (request));
+            queued = queue.size();
+        }
+
+        // Workers only need waking to start a batch's clock or when a batch fills up
+        if (queued == 1 || queued >= maxBatchSize)
+        {
+            wakeUp.notify_one();
+        }
+
+        return result;
+    }
+
+    void InferenceExecutor::updateWeights (const Network& network)
+    {
+        assert (ownedWeights != nullptr);
+        ownedWeights->publish (network);
+    }
+
+    void InferenceExecutor::run()
+    {
+        std::vector<Request> batch;
+        std::vector<double> inputs, outputs;
+        batch.reserve (maxBatchSize);
+
+        std::unique_lock<std::mutex> lock (queueMutex);
+        for (;;)
+        {
+            wakeUp.wait (lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty())
+            {
+                return; // stopping, and nothing left to drain
+            }
+
+            const Clock::time_point deadline = queue.front().submitted + maxWait;
+            wakeUp.wait_until (lock, deadline, [this] { return stopping || queue.size() >= maxBatchSize; });
+
+            const std::size_t count = std::min (queue.size(), maxBatchSize);
+            for (std::size_t r = 0; r < count; ++r)
+            {
+                batch.push_back (std::move (queue.front()));
+                queue.pop_front();
+            }
+
+            if (batch.empty())
+            {
+                continue; // another worker took them
+            }
+
+            // Hand a waiting worker the rest of the queue while this batch runs
+            if (!queue.empty())
+            {
+                wakeUp.notify_one();
+            }
+
+            lock.unlock();
+            execute (batch, inputs, outputs);
+            batch.clear();
+            lock.lock();
+        }
+    }
+
+    void InferenceExecutor::execute (std::vector<Request>& batch, std::vector<double>& inputs, std::vector<double>& outputs)
+    {
+        auto snapshot = weights->acquire();
+        if (!snapshot)
+        {
+            for (Request& request : batch)
+            {
+                request.result.set_exception (std::make_exception_ptr (std::runtime_error ("No weights have been published")));
+            }
+            return;
+        }
+
+        const std::size_t numInputs = snapshot->getTopology().front();
+        const std::size_t numOutputs = snapshot->getTopology().back();
+
+        // Reject malformed requests individually and pack the rest contiguously
+        auto valid = std::stable_partition (batch.begin(), batch.end(),
+                                            [&] (const Request& request) { return request.inputVals.size() == numInputs; });
+        for (auto it = valid; it != batch.end(); ++it)
+        {
+            it->result.set_exception (std::make_exception_ptr (std::invalid_argument ("Input size does not match the model")));
+        }
+
+        const std::size_t batchSize = static_cast<std::size_t> (valid - batch.begin());
+        if (batchSize == 0)
+        {
+            return;
+        }
+
+        inputs.resize (batchSize * numInputs);
+        outputs.resize (batchSize * numOutputs);
+
+        for (std::size_t b = 0; b < batchSize; ++b)
+        {
+            std::copy (batch[b].inputVals.begin(), batch[b].inputVals.end(), inputs.begin() + b * numInputs);
+        }
+
+        snapshot->feedForwardBatch (inputs.data(), batchSize, outputs.data());
+
+        // Count the batch before completing it, so callers that have their results also see them in the stats
+        const Clock::time_point finished = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock (statsMutex);
+            // Rejected requests were never run, so only the valid ones count
+            for (std::size_t b = 0; b < batchSize; ++b)
+            {
+                stats.latency.record (std::chrono::duration<double, std::micro> (finished - batch[b].submitted).count());
+            }
+            stats.numRequests += batchSize;
+            stats.numBatches += 1;
+            stats.batchSizes[batchSize] += 1;
+        }
+
+        for (std::size_t b = 0; b < batchSize; ++b)
+        {
+            batch[b].result.set_value (std::vector<double> (outputs.begin() + b * numOutputs, outputs.begin() + (b + 1) * numOutputs));
+        }
+    }
+
+    InferenceStats InferenceExecutor::getStats() const
+    {
+        std::lock_guard<std::mutex> lock (statsMutex);
+
+        InferenceStats result = stats;
+        result.meanBatchSize = stats.numBatches > 0 ? static_cast<double> (stats.numRequests) / static_cast<double> (stats.numBatches) : 0.0;
+        result.p50Micros = stats.latency.percentile (0.50);
+        result.p99Micros = stats.latency.percentile (0.99);
+        return result;
+    }
+
+    void InferenceExecutor::resetStats()
+    {
+        std::lock_guard<std::mutex> lock (statsMutex);
+        stats = InferenceStats();
+        stats.batchSizes.assign (maxBatchSize + 1, 0);
+    }
+}
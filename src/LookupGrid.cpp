@@ -0,0 +1,300 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "LookupGrid.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace ML
+{
+    namespace
+    {
+        // Nodes (or error samples) per forward pass while baking and measuring
+        constexpr std::size_t bakeBatch = 256;
+
+        // Where x falls on an axis: the node at or below it (never the last) and the fraction past it
+        void locate (const GridAxis& axis, double x, std::size_t& index, double& fraction)
+        {
+            const double last = static_cast<double> (axis.points - 1);
+            const double t = std::clamp ((x - axis.low) / (axis.high - axis.low) * last, 0.0, last);
+            index = std::min (static_cast<std::size_t> (t), static_cast<std::size_t> (axis.points - 2));
+            fraction = t - static_cast<double> (index);
+        }
+
+        double nodePosition (const GridAxis& axis, std::size_t index)
+        {
+            return axis.low + (axis.high - axis.low) * static_cast<double> (index) / static_cast<double> (axis.points - 1);
+        }
+
+        // Per-axis node offsets and weights; axes the network lacks get one tap of weight 1
+        template <std::size_t Taps>
+        struct Stencil
+        {
+            std::size_t count[LookupGrid::maxInputs];
+            std::size_t offset[LookupGrid::maxInputs][Taps];
+            double weight[LookupGrid::maxInputs][Taps];
+        };
+
+        template <std::size_t Taps>
+        void blend (const Stencil<Taps>& stencil, const double* values, std::size_t numOutputs, double* outputVals)
+        {
+            std::fill_n (outputVals, numOutputs, 0.0);
+            for (std::size_t a = 0; a < stencil.count[0]; ++a)
+            {
+                for (std::size_t b = 0; b < stencil.count[1]; ++b)
+                {
+                    for (std::size_t c = 0; c < stencil.count[2]; ++c)
+                    {
+                        const double w = stencil.weight[0][a] * stencil.weight[1][b] * stencil.weight[2][c];
+                        const double* node = values + (stencil.offset[0][a] + stencil.offset[1][b] + stencil.offset[2][c]) * numOutputs;
+                        for (std::size_t n = 0; n < numOutputs; ++n)
+                        {
+                            outputVals[n] += w * node[n];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    LookupGrid::LookupGrid (const Network& net, std::vector<GridAxis> gridAxes, GridInterpolation interp)
+        : network (net), axes (std::move (gridAxes)), interpolation (interp)
+    {
+        const std::vector<unsigned>& topology = network.getTopology();
+        const std::size_t numInputs = topology.front();
+
+        if (numInputs == 0 || numInputs > maxInputs || axes.size() != numInputs)
+        {
+            std::cerr << "Error: A lookup grid needs one axis per input and at most " << maxInputs
+                      << " inputs; the network has " << numInputs << " and " << axes.size() << " axes were given\n";
+            return;
+        }
+        for (const GridAxis& axis : axes)
+        {
+            if (axis.points < 2 || !(axis.high > axis.low))
+            {
+                std::cerr << "Error: Every lookup grid axis needs at least two points and high above low\n";
+                return;
+            }
+        }
+
+        numOutputs = topology.back();
+        numNodes = 1;
+        for (std::size_t d = numInputs; d-- > 0;)
+        {
+            strides[d] = numNodes;
+            numNodes *= axes[d].points;
+        }
+        values.resize (numNodes * numOutputs);
+        valid = true;
+    }
+
+    void LookupGrid::bake()
+    {
+        if (!valid)
+        {
+            return;
+        }
+
+        const std::size_t numInputs = axes.size();
+        std::vector<double> inputs (bakeBatch * numInputs);
+
+        for (std::size_t start = 0; start < numNodes; start += bakeBatch)
+        {
+            const std::size_t count = std::min (bakeBatch, numNodes - start);
+            for (std::size_t b = 0; b < count; ++b)
+            {
+                for (std::size_t d = 0; d < numInputs; ++d)
+                {
+                    const std::size_t index = (start + b) / strides[d] % axes[d].points;
+                    inputs[b * numInputs + d] = nodePosition (axes[d], index);
+                }
+            }
+            Network::feedForwardBatch (network.getTopology(), network.getWeightData(), inputs.data(), count,
+                                       values.data() + start * numOutputs);
+        }
+
+        bakedVersion = network.getWeightsVersion();
+        baked = true;
+        ++bakeCount;
+    }
+
+    void LookupGrid::refresh()
+    {
+        if (!baked || bakedVersion != network.getWeightsVersion())
+        {
+            bake();
+        }
+    }
+
+    void LookupGrid::query (const double* inputVals, double* outputVals)
+    {
+        if (!valid)
+        {
+            return;
+        }
+
+        refresh();
+        if (interpolation == GridInterpolation::Cubic)
+        {
+            queryCubic (inputVals, outputVals);
+        }
+        else
+        {
+            queryLinear (inputVals, outputVals);
+        }
+    }
+
+    void LookupGrid::query (const std::vector<double>& inputVals, std::vector<double>& outputVals)
+    {
+        if (inputVals.size() != axes.size())
+        {
+            std::cerr << "Error: Lookup grid queries need " << axes.size() << " inputs, got " << inputVals.size() << "\n";
+            return;
+        }
+        outputVals.resize (numOutputs);
+        query (inputVals.data(), outputVals.data());
+    }
+
+    void LookupGrid::queryLinear (const double* inputVals, double* outputVals) const
+    {
+        Stencil<2> stencil;
+        for (std::size_t d = 0; d < maxInputs; ++d)
+        {
+            if (d >= axes.size())
+            {
+                stencil.count[d] = 1;
+                stencil.offset[d][0] = 0;
+                stencil.weight[d][0] = 1.0;
+                continue;
+            }
+
+            std::size_t index;
+            double f;
+            locate (axes[d], inputVals[d], index, f);
+            stencil.count[d] = 2;
+            stencil.offset[d][0] = index * strides[d];
+            stencil.offset[d][1] = (index + 1) * strides[d];
+            stencil.weight[d][0] = 1.0 - f;
+            stencil.weight[d][1] = f;
+        }
+        blend (stencil, values.data(), numOutputs, outputVals);
+    }
+
+    void LookupGrid::queryCubic (const double* inputVals, double* outputVals) const
+    {
+        Stencil<4> stencil;
+        for (std::size_t d = 0; d < maxInputs; ++d)
+        {
+            if (d >= axes.size())
+            {
+                stencil.count[d] = 1;
+                stencil.offset[d][0] = 0;
+                stencil.weight[d][0] = 1.0;
+                continue;
+            }
+
+            std::size_t index;
+            double f;
+            locate (axes[d], inputVals[d], index, f);
+
+            // Catmull-Rom through nodes index - 1 .. index + 2
+            const double f2 = f * f;
+            const double f3 = f2 * f;
+            double* w = stencil.weight[d];
+            w[0] = 0.5 * (-f3 + 2.0 * f2 - f);
+            w[1] = 0.5 * (3.0 * f3 - 5.0 * f2 + 2.0);
+            w[2] = 0.5 * (-3.0 * f3 + 4.0 * f2 + f);
+            w[3] = 0.5 * (f3 - f2);
+
+            // Past either end the missing node is extrapolated linearly from the two inside it.
+            // Repeating the edge node instead would flatten the slope and make the edge cells
+            // worse than linear interpolation.
+            const bool atStart = index == 0;
+            const bool atEnd = index + 2 == axes[d].points;
+            if (atStart)
+            {
+                w[1] += 2.0 * w[0];
+                w[2] -= w[0];
+                w[0] = 0.0;
+            }
+            if (atEnd)
+            {
+                w[2] += 2.0 * w[3];
+                w[1] -= w[3];
+                w[3] = 0.0;
+            }
+
+            stencil.count[d] = 4;
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                const std::size_t node = std::clamp<std::size_t> (index + k, 1, axes[d].points) - 1;
+                stencil.offset[d][k] = node * strides[d];
+            }
+        }
+        blend (stencil, values.data(), numOutputs, outputVals);
+    }
+
+    GridErrorReport LookupGrid::measureError (std::size_t numSamples, std::uint64_t seed)
+    {
+        GridErrorReport report;
+        if (!valid || numSamples == 0)
+        {
+            return report;
+        }
+
+        refresh();
+
+        const std::size_t numInputs = axes.size();
+        Random random (seed);
+        std::vector<double> inputs (bakeBatch * numInputs);
+        std::vector<double> exact (bakeBatch * numOutputs);
+        std::vector<double> approx (numOutputs);
+        double errorSum = 0.0;
+
+        for (std::size_t start = 0; start < numSamples; start += bakeBatch)
+        {
+            const std::size_t count = std::min (bakeBatch, numSamples - start);
+            for (std::size_t i = 0; i < count * numInputs; ++i)
+            {
+                const GridAxis& axis = axes[i % numInputs];
+                inputs[i] = random.uniform (axis.low, axis.high);
+            }
+            Network::feedForwardBatch (network.getTopology(), network.getWeightData(), inputs.data(), count, exact.data());
+
+            for (std::size_t b = 0; b < count; ++b)
+            {
+                const double* input = inputs.data() + b * numInputs;
+                if (interpolation == GridInterpolation::Cubic)
+                {
+                    queryCubic (input, approx.data());
+                }
+                else
+                {
+                    queryLinear (input, approx.data());
+                }
+
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    const double error = std::abs (approx[n] - exact[b * numOutputs + n]);
+                    errorSum += error;
+                    if (error > report.maxError || report.worstInput.empty())
+                    {
+                        report.maxError = error;
+                        report.worstInput.assign (input, input + numInputs);
+                    }
+                }
+            }
+        }
+
+        report.samplesChecked = numSamples;
+        report.meanError = errorSum / static_cast<double> (numSamples * numOutputs);
+        return report;
+    }
+}
@@ -0,0 +1,150 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "Loss.h"
+#include "NN.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ML
+{
+    namespace
+    {
+        // log (1 + e^x) without overflow for large x or lost precision for very negative x
+        inline double softplus (double x)
+        {
+            return std::max (x, 0.0) + std::log1p (std::exp (-std::abs (x)));
+        }
+
+        inline double sigmoid (double x)
+        {
+            if (x >= 0.0)
+            {
+                return 1.0 / (1.0 + std::exp (-x));
+            }
+            const double e = std::exp (x);
+            return e / (1.0 + e);
+        }
+
+        inline double sign (double x)
+        {
+            return static_cast<double> ((x > 0.0) - (x < 0.0));
+        }
+    }
+
+    const char* toString (Loss loss)
+    {
+        switch (loss)
+        {
+            case Loss::MeanSquared:             return "mean squared";
+            case Loss::MeanAbsolute:            return "mean absolute";
+            case Loss::Huber:                   return "huber";
+            case Loss::BinaryCrossEntropy:      return "binary cross-entropy";
+            case Loss::CategoricalCrossEntropy: return "categorical cross-entropy";
+        }
+        return "unknown";
+    }
+
+    double computeLoss (Loss loss, std::size_t numOutputs, const double* outputs, const double* sums,
+                        const double* targets, double* gradients, double huberDelta)
+    {
+        double total = 0.0;
+
+        switch (loss)
+        {
+            case Loss::MeanSquared:
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    const double delta = targets[n] - outputs[n];
+                    total += delta * delta;
+                    gradients[n] = delta * Neuron::transferFunctionDerivative (outputs[n]);
+                }
+                return std::sqrt (total / numOutputs);
+
+            case Loss::MeanAbsolute:
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    const double delta = targets[n] - outputs[n];
+                    total += std::abs (delta);
+                    gradients[n] = sign (delta) * Neuron::transferFunctionDerivative (outputs[n]);
+                }
+                return total / numOutputs;
+
+            case Loss::Huber:
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    const double delta = targets[n] - outputs[n];
+                    const double clipped = std::clamp (delta, -huberDelta, huberDelta);
+                    total += std::abs (delta) <= huberDelta ? 0.5 * delta * delta : huberDelta * (std::abs (delta) - 0.5 * huberDelta);
+                    gradients[n] = clipped * Neuron::transferFunctionDerivative (outputs[n]);
+                }
+                return total / numOutputs;
+
+            case Loss::BinaryCrossEntropy:
+                // p = sigmoid (2z) = (1 + tanh z) / 2, so -dL/dz = 2 (t - p)
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    const double x = 2.0 * sums[n];
+                    total += softplus (x) - targets[n] * x;
+                    gradients[n] = 2.0 * (targets[n] - sigmoid (x));
+                }
+                return total / numOutputs;
+
+            case Loss::CategoricalCrossEntropy:
+            {
+                const double largest = *std::max_element (sums, sums + numOutputs);
+                double sumExp = 0.0;
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    gradients[n] = std::exp (sums[n] - largest);
+                    sumExp += gradients[n];
+                }
+
+                // -log p_n = largest + log (sumExp) - z_n, and -dL/dz_n = t_n - p_n
+                const double logNormaliser = largest + std::log (sumExp);
+                const double invSumExp = 1.0 / sumExp;
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    total += targets[n] * (logNormaliser - sums[n]);
+                    gradients[n] = targets[n] - gradients[n] * invSumExp;
+                }
+                return total;
+            }
+        }
+
+        return total;
+    }
+
+    void computePredictions (Loss loss, std::size_t numOutputs, const double* outputs, const double* sums, double* predictions)
+    {
+        if (loss == Loss::BinaryCrossEntropy)
+        {
+            for (std::size_t n = 0; n < numOutputs; ++n)
+            {
+                predictions[n] = sigmoid (2.0 * sums[n]);
+            }
+        }
+        else if (loss == Loss::CategoricalCrossEntropy)
+        {
+            const double largest = *std::max_element (sums, sums + numOutputs);
+            double sumExp = 0.0;
+            for (std::size_t n = 0; n < numOutputs; ++n)
+            {
+                predictions[n] = std::exp (sums[n] - largest);
+                sumExp += predictions[n];
+            }
+            for (std::size_t n = 0; n < numOutputs; ++n)
+            {
+                predictions[n] /= sumExp;
+            }
+        }
+        else
+        {
+            std::copy_n (outputs, numOutputs, predictions);
+        }
+    }
+}
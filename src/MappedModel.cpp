@@ -0,0 +1,227 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "MappedModel.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TINYML_HAS_MMAP 1
+#endif
+
+namespace ML
+{
+    namespace
+    {
+        constexpr char fileMagic[8] = { 'T', 'I', 'N', 'Y', 'M', 'L', 'M', 'M' };
+        constexpr std::uint32_t fileVersion = 1;
+        constexpr std::uint32_t byteOrderMark = 0x01020304;
+        constexpr std::size_t minimumAlignment = 4096;
+
+        // Followed by numLayers uint32 layer sizes, then padding up to weightsOffset
+        struct FileHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+            std::uint32_t loss;
+            std::uint32_t numLayers;
+            std::uint64_t numWeights;
+            std::uint64_t weightsOffset;
+        };
+
+        std::size_t pageSize()
+        {
+#ifdef TINYML_HAS_MMAP
+            return std::max<std::size_t> (static_cast<std::size_t> (sysconf (_SC_PAGESIZE)), minimumAlignment);
+#else
+            return minimumAlignment;
+#endif
+        }
+    }
+
+    bool MappedModel::write (const Network& network, const std::string& path)
+    {
+        const std::vector<unsigned>& topology = network.getTopology();
+
+        FileHeader header {};
+        std::memcpy (header.magic, fileMagic, sizeof (fileMagic));
+        header.version = fileVersion;
+        header.byteOrder = byteOrderMark;
+        header.loss = static_cast<std::uint32_t> (network.getLoss());
+        header.numLayers = static_cast<std::uint32_t> (topology.size());
+        header.numWeights = network.getNumWeights();
+
+        const std::size_t alignment = pageSize();
+        const std::size_t headerBytes = sizeof (FileHeader) + topology.size() * sizeof (std::uint32_t);
+        header.weightsOffset = (headerBytes + alignment - 1) / alignment * alignment;
+
+        // Written beside the target and renamed over it, so readers never map a partial file
+        // and processes holding the old file keep its contents
+        const std::string temporaryPath = path + ".partial";
+        {
+            std::ofstream file (temporaryPath, std::ios::binary | std::ios::trunc);
+            const std::vector<std::uint32_t> layerSizes (topology.begin(), topology.end());
+            const std::vector<char> padding (header.weightsOffset - headerBytes, 0);
+
+            file.write (reinterpret_cast<const char*> (&header), sizeof (header));
+            file.write (reinterpret_cast<const char*> (layerSizes.data()), static_cast<std::streamsize> (layerSizes.size() * sizeof (std::uint32_t)));
+            file.write (padding.data(), static_cast<std::streamsize> (padding.size()));
+            file.write (reinterpret_cast<const char*> (network.getWeightData()),
+                        static_cast<std::streamsize> (network.getNumWeights() * sizeof (double)));
+
+            if (!file)
+            {
+                std::cerr << "Error: Unable to write mapped model " << temporaryPath << "\n";
+                std::remove (temporaryPath.c_str());
+                return false;
+            }
+        }
+
+        if (std::rename (temporaryPath.c_str(), path.c_str()) != 0)
+        {
+            std::cerr << "Error: Unable to move mapped model into place at " << path << "\n";
+            std::remove (temporaryPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+#ifdef TINYML_HAS_MMAP
+    std::unique_ptr<MappedModel> MappedModel::open (const std::string& path)
+    {
+        const int fd = ::open (path.c_str(), O_RDONLY);
+        struct stat status;
+        if (fd < 0 || fstat (fd, &status) != 0)
+        {
+            std::cerr << "Error: Unable to open mapped model " << path << "\n";
+            if (fd >= 0)
+            {
+                close (fd);
+            }
+            return nullptr;
+        }
+
+        const std::size_t fileBytes = static_cast<std::size_t> (status.st_size);
+        const void* mapping = fileBytes >= sizeof (FileHeader) ? mmap (nullptr, fileBytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+        close (fd);
+        if (mapping == MAP_FAILED)
+        {
+            std::cerr << "Error: Unable to map " << path << "; it may be too short to be a mapped model\n";
+            return nullptr;
+        }
+
+        std::unique_ptr<MappedModel> model (new MappedModel());
+        model->mapping = mapping;
+        model->mappingBytes = fileBytes;
+
+        FileHeader header;
+        std::memcpy (&header, mapping, sizeof (header));
+        const std::size_t headerBytes = sizeof (FileHeader) + static_cast<std::size_t> (header.numLayers) * sizeof (std::uint32_t);
+
+        bool valid = std::memcmp (header.magic, fileMagic, sizeof (fileMagic)) == 0 && header.version == fileVersion
+                     && header.byteOrder == byteOrderMark && header.loss <= static_cast<std::uint32_t> (Loss::CategoricalCrossEntropy)
+                     && header.numLayers >= 2 && headerBytes <= fileBytes && header.weightsOffset >= headerBytes
+                     && header.weightsOffset % alignof (double) == 0 && header.weightsOffset <= fileBytes
+                     && header.numWeights <= (fileBytes - header.weightsOffset) / sizeof (double);
+
+        if (valid)
+        {
+            model->topology.resize (header.numLayers);
+            const unsigned char* layerSizes = static_cast<const unsigned char*> (mapping) + sizeof (FileHeader);
+            for (std::size_t l = 0; l < header.numLayers; ++l)
+            {
+                std::uint32_t size;
+                std::memcpy (&size, layerSizes + l * sizeof (size), sizeof (size));
+                model->topology[l] = size;
+                valid = valid && size > 0;
+            }
+            valid = valid && Network::countWeights (model->topology) == header.numWeights;
+        }
+
+        if (!valid)
+        {
+            std::cerr << "Error: " << path << " is not a mapped model this build can read\n";
+            return nullptr;
+        }
+
+        model->loss = static_cast<Loss> (header.loss);
+        model->numWeights = static_cast<std::size_t> (header.numWeights);
+        model->weights = reinterpret_cast<const double*> (static_cast<const char*> (mapping) + header.weightsOffset);
+        return model;
+    }
+
+    MappedModel::~MappedModel()
+    {
+        if (mapping != nullptr)
+        {
+            munmap (const_cast<void*> (mapping), mappingBytes);
+        }
+    }
+#else
+    std::unique_ptr<MappedModel> MappedModel::open (const std::string& path)
+    {
+        std::cerr << "Error: Mapped models need POSIX mmap; cannot open " << path << "\n";
+        return nullptr;
+    }
+
+    MappedModel::~MappedModel() = default;
+#endif
+
+    bool MappedModel::checkInputSize (std::size_t numInputs) const
+    {
+        if (numInputs != topology.front())
+        {
+            std::cerr << "Error: Mapped model expects " << topology.front() << " inputs but got " << numInputs << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<double> MappedModel::feedForward (const std::vector<double>& inputVals) const
+    {
+        if (!checkInputSize (inputVals.size()))
+        {
+            return {};
+        }
+
+        std::vector<double> resultVals (topology.back());
+        feedForward (inputVals.data(), resultVals.data());
+        return resultVals;
+    }
+
+    void MappedModel::feedForward (const double* inputVals, double* resultVals) const
+    {
+        Network::feedForward (topology, weights, inputVals, resultVals);
+    }
+
+    void MappedModel::feedForwardBatch (const double* inputVals, std::size_t batchSize, double* resultVals) const
+    {
+        Network::feedForwardBatch (topology, weights, inputVals, batchSize, resultVals);
+    }
+
+    std::vector<double> MappedModel::predict (const std::vector<double>& inputVals) const
+    {
+        if (!checkInputSize (inputVals.size()))
+        {
+            return {};
+        }
+
+        const std::size_t numOutputs = topology.back();
+        std::vector<double> outputs (numOutputs), sums (numOutputs), predictions (numOutputs);
+        Network::feedForwardBatch (topology, weights, inputVals.data(), 1, outputs.data(), sums.data());
+        computePredictions (loss, numOutputs, outputs.data(), sums.data(), predictions.data());
+        return predictions;
+    }
+}
@@ -0,0 +1,77 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "Memory.h"
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
+namespace ML
+{
+    namespace
+    {
+        // Constant-initialised, so touching them from inside operator new never allocates
+        thread_local AllocationStats threadStats;
+        std::atomic<bool> hooksInstalled { false };
+
+        void writeRow (std::ostream& out, const std::string& name, std::size_t weights, std::size_t optimizer,
+                       std::size_t activations, std::size_t caches, std::size_t overhead, std::size_t total)
+        {
+            out << std::left << std::setw (8) << name << std::right << std::setw (12) << weights << std::setw (12) << optimizer
+                << std::setw (13) << activations << std::setw (12) << caches << std::setw (12) << overhead << std::setw (12)
+                << total << "\n";
+        }
+    }
+
+    bool allocationHooksInstalled()
+    {
+        return hooksInstalled.load (std::memory_order_relaxed);
+    }
+
+    AllocationStats threadAllocationStats()
+    {
+        return threadStats;
+    }
+
+    namespace detail
+    {
+        void recordAllocation (std::size_t bytes) noexcept
+        {
+            ++threadStats.allocations;
+            threadStats.bytes += bytes;
+        }
+
+        void recordDeallocation() noexcept
+        {
+            ++threadStats.deallocations;
+        }
+
+        bool markAllocationHooksInstalled() noexcept
+        {
+            hooksInstalled.store (true, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    std::string formatMemoryReport (const MemoryReport& report)
+    {
+        std::ostringstream out;
+        out << std::left << std::setw (8) << "layer" << std::right << std::setw (12) << "weights" << std::setw (12) << "optimizer"
+            << std::setw (13) << "activations" << std::setw (12) << "caches" << std::setw (12) << "overhead" << std::setw (12)
+            << "total" << "\n";
+
+        for (std::size_t l = 0; l < report.layers.size(); ++l)
+        {
+            const LayerMemory& layer = report.layers[l];
+            writeRow (out, std::to_string (l), layer.weightBytes, layer.optimizerBytes, layer.activationBytes, layer.cacheBytes,
+                      layer.overheadBytes, layer.total());
+        }
+        writeRow (out, "total", report.weightBytes, report.optimizerBytes, report.activationBytes, report.cacheBytes,
+                  report.overheadBytes, report.total());
+        return out.str();
+    }
+}
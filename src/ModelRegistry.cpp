@@ -0,0 +1,145 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "ModelRegistry.h"
+#include "Model.h"
+#include <iostream>
+
+namespace ML
+{
+    namespace fs = std::filesystem;
+
+    ModelRegistry::ModelRegistry (std::vector<unsigned> topology, fs::path directory, std::string extension,
+                                  std::chrono::milliseconds pollInterval)
+        : topology (std::move (topology)), directory (std::move (directory)), extension (std::move (extension)),
+          pollInterval (pollInterval)
+    {
+    }
+
+    ModelRegistry::~ModelRegistry()
+    {
+        stop();
+    }
+
+    void ModelRegistry::start()
+    {
+        std::lock_guard<std::mutex> lock (watchMutex);
+        if (running)
+        {
+            return;
+        }
+
+        running = true;
+        watcher = std::thread (&ModelRegistry::watch, this);
+    }
+
+    void ModelRegistry::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock (watchMutex);
+            running = false;
+        }
+        wakeUp.notify_all();
+
+        if (watcher.joinable())
+        {
+            watcher.join();
+        }
+    }
+
+    void ModelRegistry::watch()
+    {
+        std::unique_lock<std::mutex> lock (watchMutex);
+        while (running)
+        {
+            lock.unlock();
+            poll();
+            lock.lock();
+
+            wakeUp.wait_for (lock, pollInterval, [this] { return !running; });
+        }
+    }
+
+    bool ModelRegistry::poll()
+    {
+        std::lock_guard<std::mutex> lock (pollMutex);
+
+        // Find the newest candidate file, breaking ties by name so the choice is stable
+        std::error_code ec;
+        fs::path newestPath;
+        fs::file_time_type newestTime;
+
+        for (fs::directory_iterator it (directory, ec), end; !ec && it != end; it.increment (ec))
+        {
+            if (!it->is_regular_file (ec) || (!extension.empty() && it->path().extension() != extension))
+            {
+                continue;
+            }
+
+            const fs::file_time_type time = it->last_write_time (ec);
+            if (!ec && (newestPath.empty() || time > newestTime || (time == newestTime && it->path() > newestPath)))
+            {
+                newestPath = it->path();
+                newestTime = time;
+            }
+        }
+
+        if (newestPath.empty())
+        {
+            return false;
+        }
+
+        const std::uintmax_t size = fs::file_size (newestPath, ec);
+        if (ec || (newestPath == lastAttemptPath && newestTime == lastAttemptTime && size == lastAttemptSize))
+        {
+            return false;
+        }
+
+        lastAttemptPath = newestPath;
+        lastAttemptTime = newestTime;
+        lastAttemptSize = size;
+
+        std::vector<double> weights;
+        if (!Model::readWeightsFile (newestPath.string(), weights))
+        {
+            std::cerr << "Error: Unable to read weights from " << newestPath << "\n";
+            return false;
+        }
+
+        const std::size_t numWeights = Network::countWeights (topology);
+
+        if (weights.size() != numWeights)
+        {
+            std::cerr << "Error: " << newestPath << " holds " << weights.size() << " weights but the topology needs "
+                      << numWeights << "\n";
+            return false;
+        }
+
+        publisher.publish (topology, weights.data());
+        currentPath = newestPath;
+        ++numReloads;
+        return true;
+    }
+
+    std::vector<double> ModelRegistry::feedForward (const std::vector<double>& inputVals) const
+    {
+        auto snapshot = publisher.acquire();
+        return snapshot ? snapshot->feedForward (inputVals) : std::vector<double>();
+    }
+
+    fs::path ModelRegistry::getCurrentPath() const
+    {
+        std::lock_guard<std::mutex> lock (pollMutex);
+        return currentPath;
+    }
+
+    std::uint64_t ModelRegistry::getNumReloads() const
+    {
+        std::lock_guard<std::mutex> lock (pollMutex);
+        return numReloads;
+    }
+}
@@ -9,63 +9,54 @@
 
 namespace ML
 {
-    Neuron::Neuron(unsigned numOutputs, unsigned neuronIndex)
-        : error(0.0f), gradient(0.0f), outputVal(0.0f), recentAverageError(0.0f), index(neuronIndex)
+    Neuron::Neuron(unsigned numOutputs, unsigned neuronIndex, double* outputVal, double* gradient,
+                   double* outputWeights, double* deltaWeights)
+        : outputVal(outputVal), gradient(gradient), outputWeights(outputWeights), deltaWeights(deltaWeights),
+          numOutputs(numOutputs), index(neuronIndex)
     {
-        outputWeights.reserve(numOutputs);
-        for (unsigned i = 0; i < numOutputs; ++i) {
-            auto connectionPtr = std::make_unique<connection>();
-            connectionPtr->weight = static_cast<double>(rand()) / RAND_MAX;
-            outputWeights.push_back(std::move(connectionPtr));
-        }
     }
 
     void Neuron::calcHiddenGradients(const Layer& nextLayer)
     {
         double dow = sumDOW(nextLayer);
-        gradient = dow * Neuron::transferFunctionDerivative(outputVal);
+        *gradient = dow * Neuron::transferFunctionDerivative(*outputVal);
     }
 
     void Neuron::calcOutputGradients(double targetVal)
     {
-        double delta = targetVal - outputVal;
-        gradient = delta * Neuron::transferFunctionDerivative(outputVal);
+        double delta = targetVal - *outputVal;
+        *gradient = delta * Neuron::transferFunctionDerivative(*outputVal);
     }
 
-    void Neuron::feedForward(Layer& prevLayer)
+    void Neuron::feedForward(const Layer& prevLayer)
     {
         double sum = 0.0;
         for (const auto& neuron : prevLayer) {
-            sum += neuron->getOutputVal() * neuron->outputWeights[index]->weight;
+            sum += neuron.getOutputVal() * neuron.outputWeights[index];
         }
-        outputVal = Neuron::transferFunction(sum);
+        *outputVal = Neuron::transferFunction(sum);
     }
 
     double Neuron::getOutputVal() const
     {
-        return outputVal;
+        return *outputVal;
     }
 
-    void Neuron::updateInputWeights(Layer& prevLayer)
+    void Neuron::updateInputWeights(Layer& prevLayer, double learningRate, double momentum)
     {
         for (auto& neuron : prevLayer) {
-            double oldDeltaWeight = neuron->outputWeights[index]->deltaweight;
-            double newDeltaWeight = eta * neuron->getOutputVal() * gradient + alpha * oldDeltaWeight;
-            neuron->outputWeights[index]->deltaweight = newDeltaWeight;
-            neuron->outputWeights[index]->weight += newDeltaWeight;
+            double oldDeltaWeight = neuron.deltaWeights[index];
+            double newDeltaWeight = learningRate * neuron.getOutputVal() * *gradient + momentum * oldDeltaWeight;
+            neuron.deltaWeights[index] = newDeltaWeight;
+            neuron.outputWeights[index] += newDeltaWeight;
         }
     }
 
-    double Neuron::randomWeight()
-    {
-        return static_cast<double>(rand()) / RAND_MAX;
-    }
-
     double Neuron::sumDOW(const Layer& nextLayer) const
     {
         double sum = 0.0;
         for (unsigned i = 0; i < nextLayer.size() - 1; ++i) {
-            sum += outputWeights[i]->weight * nextLayer[i]->gradient;
+            sum += outputWeights[i] * nextLayer[i].getGradient();
         }
         return sum;
     }
@@ -82,7 +73,12 @@ namespace ML
 
     void Neuron::setOutputVal(double value)
     {
-        outputVal = value;
+        *outputVal = value;
+    }
+
+    double Neuron::getGradient() const
+    {
+        return *gradient;
     }
 
     int Neuron::getIndex() const
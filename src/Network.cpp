@@ -5,116 +5,577 @@
  * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 22/04/2022
 *****************************************************************************/
 
-#include <ctime> // For time()
 #include <cassert>    // For assert()
+#include <algorithm>
+#include <iostream>
+#include <limits>
 #include "Network.h"
+#include "Gemm.h"
+#include "Parallel.h"
 
 namespace ML
 {
-    Network::Network (const std::vector<unsigned>& topology)
+    namespace
     {
-        srand (static_cast<unsigned int>(time (NULL)));
-        unsigned numLayers = static_cast<unsigned>(topology.size());
+        // Weights are drawn in fixed-size chunks, each from its own random stream, so the
+        // result depends only on the seed and never on how many threads did the work.
+        constexpr std::size_t weightsPerStream = 1 << 14;
+        constexpr std::size_t parallelInitThreshold = 1 << 16;
 
-        for (unsigned layerNum = 0; layerNum < numLayers; ++layerNum)
+        // out[n] = f (sum_i in[i] * w[i][n]) for one layer: a gemvT over the weight rows,
+        // each source neuron's contiguous row accumulated in turn; numInputs includes the bias neuron.
+        // The sums before f are also kept in `sums` when it is given.
+        inline void forwardLayer (const double* in, std::size_t numInputs, const double* w, std::size_t numOutputs, double* out,
+                                  double* sums = nullptr)
         {
-            layers.emplace_back();
-            unsigned numOutputs = (layerNum == topology.size() - 1) ? 0 : topology[layerNum + 1];
+            gemvT (numInputs, numOutputs, w, numOutputs, in, 0.0, out);
 
-            // Create neurons for this layer, including a bias neuron
-            for (unsigned neuronNum = 0; neuronNum <= topology[layerNum]; ++neuronNum)
+            if (sums != nullptr)
             {
-                layers.back().push_back(std::make_unique<Neuron>(numOutputs, neuronNum));
+                std::copy_n (out, numOutputs, sums);
             }
 
-            // Set the bias neuron's output to 0.0
-            layers.back().back()->setOutputVal(0.0);
+            for (std::size_t n = 0; n < numOutputs; ++n)
+            {
+                out[n] = Neuron::transferFunction (out[n]);
+            }
+        }
+
+        // forwardLayer over a batch of samples stored with the given strides: one gemm of the
+        // batch's activations against the layer's weights, then the transfer function. The
+        // sums before it are also copied to `sums` (numOutputs per sample) when it is given.
+        inline void forwardLayerBatch (const double* in, std::size_t inStride, std::size_t numInputs, const double* w,
+                                       std::size_t numOutputs, double* out, std::size_t outStride, std::size_t batchSize,
+                                       double* sums = nullptr)
+        {
+            gemm (batchSize, numOutputs, numInputs, in, inStride, w, numOutputs, 0.0, out, outStride);
+
+            for (std::size_t b = 0; b < batchSize; ++b)
+            {
+                double* sample = out + b * outStride;
+                if (sums != nullptr)
+                {
+                    std::copy_n (sample, numOutputs, sums + b * numOutputs);
+                }
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    sample[n] = Neuron::transferFunction (sample[n]);
+                }
+            }
         }
     }
 
-    void Network::normalizeWeights (int connection_index)
+    Network::Network (const std::vector<unsigned>& topology, WeightInit init, std::uint64_t seed)
+        : weightInit (init), seed (seed)
     {
-        double sum_weights_squared = 0.0;
+        setTopology (topology);
+    }
 
-        for (const Layer& layer : layers)
+    std::size_t Network::requiredBytes (const std::vector<unsigned>& topology)
+    {
+        std::size_t bytes = 0;
+
+        for (std::size_t layerNum = 0; layerNum < topology.size(); ++layerNum)
+        {
+            const std::size_t numNeurons = topology[layerNum] + 1; // including the bias neuron
+            bytes += Arena::bytesFor<Neuron> (numNeurons);
+            bytes += 2 * Arena::bytesFor<double> (numNeurons); // output values and gradients
+        }
+
+        bytes += Arena::bytesFor<double> (topology.empty() ? 0 : topology.back()); // output sums
+        return bytes + 2 * Arena::bytesFor<double> (countWeights (topology)); // weights and delta weights
+    }
+
+    std::size_t Network::countWeights (const std::vector<unsigned>& topology)
+    {
+        std::size_t count = 0;
+        for (std::size_t layerNum = 0; layerNum + 1 < topology.size(); ++layerNum)
+        {
+            count += static_cast<std::size_t> (topology[layerNum] + 1) * topology[layerNum + 1];
+        }
+        return count;
+    }
+
+    std::vector<std::size_t> Network::layerWeightOffsets (const std::vector<unsigned>& topology)
+    {
+        std::vector<std::size_t> offsets (1, 0);
+        for (std::size_t layerNum = 0; layerNum + 1 < topology.size(); ++layerNum)
+        {
+            offsets.push_back (offsets.back() + static_cast<std::size_t> (topology[layerNum] + 1) * topology[layerNum + 1]);
+        }
+        return offsets;
+    }
+
+    MemoryReport Network::getMemoryReport() const
+    {
+        MemoryReport report;
+        const bool mixed = precision == Precision::Mixed;
+
+        for (std::size_t layerNum = 0; layerNum < layers.size(); ++layerNum)
         {
-            for (const auto& neuron : layer)
+            const Layer& layer = layers[layerNum];
+            const std::size_t numNeurons = layer.size();
+            const std::size_t layerWeights = numNeurons * layer.getNumOutputs();
+            LayerMemory memory;
+            memory.numNeurons = numNeurons;
+
+            memory.weightBytes = layerWeights * sizeof (double);
+            if (weightNorm)
             {
-                sum_weights_squared += neuron->getOutputWeights()[connection_index]->weight;
+                memory.weightBytes += (layerWeights + layer.getNumOutputs()) * sizeof (double); // directions and gains
             }
+            memory.optimizerBytes = layerWeights * sizeof (double);
+            memory.activationBytes = 2 * numNeurons * sizeof (double) + (mixed ? 2 * numNeurons * sizeof (float) : 0);
+            memory.cacheBytes = mixed ? layerWeights * sizeof (float) : 0;
+
+            // The Neuron records, the Layer view and the arena padding after each of this layer's blocks
+            memory.overheadBytes = Arena::bytesFor<Neuron> (numNeurons) + sizeof (Layer)
+                                   + 2 * (Arena::bytesFor<double> (numNeurons) - numNeurons * sizeof (double));
+            if (layerNum + 1 == layers.size())
+            {
+                memory.activationBytes += topology.back() * sizeof (double); // output sums
+                memory.overheadBytes += Arena::bytesFor<double> (topology.back()) - topology.back() * sizeof (double);
+            }
+
+            report.layers.push_back (memory);
+            report.weightBytes += memory.weightBytes;
+            report.optimizerBytes += memory.optimizerBytes;
+            report.activationBytes += memory.activationBytes;
+            report.cacheBytes += memory.cacheBytes;
+            report.overheadBytes += memory.overheadBytes;
         }
 
-        double average = sum_weights_squared / 101.0;
-        sum_weights_squared = 0.0;
+        // Storage no single layer owns: padding after the weight blocks, the arena's unused
+        // tail, slack in every vector, the incremental-forward cache and the object itself
+        const std::size_t arenaPadding = 2 * (Arena::bytesFor<double> (numWeights) - numWeights * sizeof (double));
+        report.cacheBytes += (incrementalInputs.size() + incrementalSums.size()) * sizeof (double);
+        report.overheadBytes += arenaPadding + (arena.getCapacity() - arena.getUsed()) + sizeof (Network)
+                                + detail::unusedBytes (incrementalInputs) + detail::unusedBytes (incrementalSums)
+                                + detail::unusedBytes (weightNormDirections) + detail::unusedBytes (weightNormGains)
+                                + detail::unusedBytes (workingWeights) + detail::unusedBytes (workingValues)
+                                + detail::unusedBytes (workingGradients) + (layers.capacity() - layers.size()) * sizeof (Layer)
+                                + detail::heapBytes (topology) + detail::heapBytes (weightMask) + detail::heapBytes (neuronOffsets)
+                                + detail::heapBytes (sparseActive);
+        return report;
+    }
 
-        for (const Layer& layer : layers)
+    void Network::setTopology (const std::vector<unsigned>& newTopology)
+    {
+        const std::size_t bytes = requiredBytes (newTopology);
+
+        // Reuse the existing block whenever the new network fits in it
+        if (bytes > arena.getCapacity())
+        {
+            arena = Arena (bytes);
+        }
+        else
+        {
+            arena.reset();
+        }
+
+        topology = newTopology;
+        weightMask.clear();
+        build();
+        initialiseWeights (weightInit, seed);
+    }
+
+    void Network::setWeightMask (std::vector<unsigned char> mask)
+    {
+        invalidateCaches();
+        assert (mask.empty() || mask.size() == numWeights);
+        weightMask = std::move (mask);
+        applyWeightMask();
+        syncWeightNorm();
+    }
+
+    void Network::applyWeightMask (const std::uint32_t* activeInputs, std::size_t numActive)
+    {
+        if (weightMask.empty())
+        {
+            return;
+        }
+
+        // Branch-free so the loops vectorise
+        auto maskRange = [this] (std::size_t begin, std::size_t end)
         {
-            for (const auto& neuron : layer)
+            for (std::size_t i = begin; i < end; ++i)
             {
-                neuron->getOutputWeights()[connection_index]->weight -= average;
-                sum_weights_squared += std::pow(neuron->getOutputWeights()[connection_index]->weight, 2);
+                const double keep = weightMask[i] != 0 ? 1.0 : 0.0;
+                weights[i] *= keep;
+                deltaWeights[i] *= keep;
             }
+        };
+
+        if (activeInputs == nullptr)
+        {
+            maskRange (0, numWeights);
+            return;
         }
 
-        for (const Layer& layer : layers)
+        // Only the listed first-layer rows and the layers above them moved
+        const std::size_t numHidden = topology[1];
+        for (std::size_t k = 0; k < numActive; ++k)
         {
-            for (const auto& neuron : layer)
+            const std::size_t row = static_cast<std::size_t> (activeInputs[k]) * numHidden;
+            maskRange (row, row + numHidden);
+        }
+        maskRange ((static_cast<std::size_t> (topology[0]) + 1) * numHidden, numWeights);
+    }
+
+    void Network::initialiseWeights (WeightInit init, std::uint64_t newSeed)
+    {
+        invalidateCaches();
+        weightInit = init;
+        seed = newSeed;
+        std::fill_n (deltaWeights, numWeights, 0.0);
+
+        struct Chunk
+        {
+            double* begin;
+            std::size_t count;
+            double low;
+            double high;
+            std::uint64_t stream;
+        };
+
+        std::vector<Chunk> chunks;
+
+        for (std::size_t layerNum = 0; layerNum + 1 < layers.size(); ++layerNum)
+        {
+            const double fanIn = topology[layerNum];
+            const double fanOut = topology[layerNum + 1];
+            double low = 0.0, high = 1.0;
+
+            if (init == WeightInit::Xavier)
             {
-                neuron->getOutputWeights()[connection_index]->weight /= std::sqrt(sum_weights_squared);
+                high = std::sqrt (6.0 / (fanIn + fanOut));
+                low = -high;
+            }
+            else if (init == WeightInit::He)
+            {
+                high = std::sqrt (6.0 / std::max (fanIn, 1.0));
+                low = -high;
+            }
+
+            double* layerWeights = layers[layerNum].getOutputWeights();
+            const std::size_t layerSize = layers[layerNum].size() * static_cast<std::size_t> (layers[layerNum].getNumOutputs());
+
+            for (std::size_t offset = 0, chunkNum = 0; offset < layerSize; offset += weightsPerStream, ++chunkNum)
+            {
+                chunks.push_back ({ layerWeights + offset, std::min (weightsPerStream, layerSize - offset), low, high,
+                                    (static_cast<std::uint64_t> (layerNum) << 32) | chunkNum });
             }
         }
+
+        auto fillChunk = [&] (std::size_t c)
+        {
+            const Chunk& chunk = chunks[c];
+            Random rng (seed, chunk.stream);
+            for (std::size_t i = 0; i < chunk.count; ++i)
+            {
+                chunk.begin[i] = rng.uniform (chunk.low, chunk.high);
+            }
+        };
+
+        parallelFor (chunks.size(), fillChunk, numWeights < parallelInitThreshold ? 1 : 0);
+        syncWeightNorm();
     }
 
-    void Network::updateWeights()
+    void Network::build()
     {
-        for (std::size_t layerNum = 1; layerNum < layers.size(); ++layerNum)
+        const std::size_t numLayers = topology.size();
+        layers.clear();
+        layers.reserve (numLayers);
+
+        numWeights = countWeights (topology);
+
+        weights = arena.allocate<double> (numWeights);
+        deltaWeights = arena.allocate<double> (numWeights);
+        sparseActive.clear(); // indices into the old input layer
+        sparseInputsClean = false;
+        outputSums = arena.allocate<double> (topology.back());
+        std::fill_n (outputSums, topology.back(), 0.0);
+
+        std::size_t weightOffset = 0;
+
+        for (std::size_t layerNum = 0; layerNum < numLayers; ++layerNum)
         {
-            Layer& prevLayer = layers[layerNum - 1];
+            const unsigned numNeurons = topology[layerNum] + 1; // including the bias neuron
+            const unsigned numOutputs = (layerNum == numLayers - 1) ? 0 : topology[layerNum + 1];
+
+            Neuron* neurons = arena.allocate<Neuron> (numNeurons);
+            double* outputVals = arena.allocate<double> (numNeurons);
+            double* gradients = arena.allocate<double> (numNeurons);
+            std::fill_n (outputVals, numNeurons, 0.0);
+            std::fill_n (gradients, numNeurons, 0.0);
 
-            for (auto& neuron : prevLayer)
+            double* layerWeights = weights + weightOffset;
+            double* layerDeltaWeights = deltaWeights + weightOffset;
+
+            for (unsigned neuronNum = 0; neuronNum < numNeurons; ++neuronNum)
             {
-                neuron->updateInputWeights(prevLayer);
+                const std::size_t row = static_cast<std::size_t> (neuronNum) * numOutputs;
+                new (neurons + neuronNum) Neuron (numOutputs, neuronNum, outputVals + neuronNum, gradients + neuronNum,
+                                                  layerWeights + row, layerDeltaWeights + row);
             }
+
+            layers.emplace_back (neurons, numNeurons, numOutputs, outputVals, gradients, layerWeights, layerDeltaWeights);
+            weightOffset += static_cast<std::size_t> (numNeurons) * numOutputs;
+
+            // Set the bias neuron's output to 0.0
+            layers.back().back().setOutputVal (0.0);
         }
+
+        prepareWorkingStorage();
     }
 
-    void Network::backPropagate (const std::vector<double>& targetVals)
+    void Network::normalizeWeights (int connection_index)
     {
-        // Calculate overall net error (RMS of output neuron errors)
-        Layer& outputLayer = layers.back();
-        error = 0.0;
+        invalidateCaches();
 
-        for (std::size_t n = 0; n < outputLayer.size() - 1; ++n)
+        // Neuron connection_index's incoming weights are a strided column in each layer's block
+        double sum = 0.0, sumSquares = 0.0;
+        std::size_t count = 0;
+        for (Layer& layer : layers)
         {
-            double delta = targetVals[n] - outputLayer[n]->getOutputVal();
-            error += delta * delta;
+            const std::size_t cols = layer.getNumOutputs();
+            if (connection_index < 0 || static_cast<std::size_t> (connection_index) >= cols)
+                continue;
+
+            const double* column = layer.getOutputWeights() + connection_index;
+            for (std::size_t i = 0; i < layer.size(); ++i)
+            {
+                sum += column[i * cols];
+                sumSquares += column[i * cols] * column[i * cols];
+            }
+            count += layer.size();
         }
 
-        error /= outputLayer.size() - 1;  // Average error squared
-        error = std::sqrt(error);         // RMS
+        if (count == 0)
+            return;
 
-        // Implement a recent average measurement
-        recentAverageError = (recentAverageError * recentAverageSmoothingFactor + error) / (recentAverageSmoothingFactor + 1.0);
+        const double mean = sum / static_cast<double> (count);
+        const double norm = std::sqrt (std::max (sumSquares - mean * sum, 0.0));
+        const double scale = norm > 0.0 ? 1.0 / norm : 1.0;
 
-        // Calculate output layer gradients
-        for (std::size_t n = 0; n < outputLayer.size() - 1; ++n)
+        for (Layer& layer : layers)
         {
-            outputLayer[n]->calcOutputGradients(targetVals[n]);
+            const std::size_t cols = layer.getNumOutputs();
+            if (static_cast<std::size_t> (connection_index) >= cols)
+                continue;
+
+            double* column = layer.getOutputWeights() + connection_index;
+            for (std::size_t i = 0; i < layer.size(); ++i)
+            {
+                column[i * cols] = (column[i * cols] - mean) * scale;
+            }
         }
 
-        // Calculate hidden layer gradients
-        for (std::size_t layerNum = layers.size() - 2; layerNum > 0; --layerNum)
+        applyWeightMask();
+        syncWeightNorm();
+    }
+
+    void Network::normalizeWeights (NormScope scope, bool centre, double targetNorm)
+    {
+        invalidateCaches();
+        thread_local std::vector<double> shift, scale;
+
+        double* block = weights;
+        for (std::size_t layerNum = 0; layerNum + 1 < topology.size(); ++layerNum)
+        {
+            const std::size_t rows = topology[layerNum]; // the bias row follows and is left alone
+            const std::size_t cols = topology[layerNum + 1];
+
+            if (scope == NormScope::PerNeuron)
+            {
+                // Column statistics, accumulated row by row so the inner loops vectorise
+                shift.assign (cols, 0.0);
+                scale.assign (cols, 0.0);
+                for (std::size_t i = 0; i < rows; ++i)
+                {
+                    const double* row = block + i * cols;
+                    for (std::size_t n = 0; n < cols; ++n)
+                    {
+                        shift[n] += row[n];
+                        scale[n] += row[n] * row[n];
+                    }
+                }
+
+                for (std::size_t n = 0; n < cols; ++n)
+                {
+                    const double sum = shift[n];
+                    const double mean = centre && rows > 0 ? sum / static_cast<double> (rows) : 0.0;
+                    const double norm = std::sqrt (std::max (scale[n] - 2.0 * mean * sum + rows * mean * mean, 0.0));
+                    shift[n] = mean;
+                    scale[n] = norm > 0.0 ? targetNorm / norm : 1.0;
+                }
+            }
+            else
+            {
+                const std::size_t count = rows * cols;
+                double sum = 0.0, sumSquares = 0.0;
+                for (std::size_t k = 0; k < count; ++k)
+                {
+                    sum += block[k];
+                    sumSquares += block[k] * block[k];
+                }
+
+                const double mean = centre && count > 0 ? sum / static_cast<double> (count) : 0.0;
+                const double norm = std::sqrt (std::max (sumSquares - 2.0 * mean * sum + count * mean * mean, 0.0));
+                shift.assign (cols, mean);
+                scale.assign (cols, norm > 0.0 ? targetNorm / norm : 1.0);
+            }
+
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                double* row = block + i * cols;
+                for (std::size_t n = 0; n < cols; ++n)
+                {
+                    row[n] = (row[n] - shift[n]) * scale[n];
+                }
+            }
+
+            block += (rows + 1) * cols;
+        }
+
+        applyWeightMask();
+        syncWeightNorm();
+    }
+
+    void Network::setWeightNorm (bool enabled)
+    {
+        weightNorm = enabled;
+        if (enabled)
+        {
+            syncWeightNorm();
+        }
+        else
+        {
+            weightNormDirections.clear();
+            weightNormGains.clear();
+        }
+    }
+
+    void Network::syncWeightNorm()
+    {
+        if (!weightNorm)
         {
-            Layer& hiddenLayer = layers[layerNum];
-            Layer& nextLayer = layers[layerNum + 1];
+            return;
+        }
+
+        weightNormDirections.assign (weights, weights + numWeights);
+        weightNormGains.clear();
 
-            for (auto& neuron : hiddenLayer)
+        const double* block = weights;
+        for (std::size_t layerNum = 0; layerNum + 1 < topology.size(); ++layerNum)
+        {
+            const std::size_t rows = topology[layerNum];
+            const std::size_t cols = topology[layerNum + 1];
+            const std::size_t first = weightNormGains.size();
+            weightNormGains.resize (first + cols, 0.0);
+            double* gains = weightNormGains.data() + first;
+
+            for (std::size_t i = 0; i < rows; ++i)
             {
-                neuron->calcHiddenGradients(nextLayer);
+                const double* row = block + i * cols;
+                for (std::size_t n = 0; n < cols; ++n)
+                {
+                    gains[n] += row[n] * row[n];
+                }
+            }
+            for (std::size_t n = 0; n < cols; ++n)
+            {
+                gains[n] = std::sqrt (gains[n]);
             }
+
+            block += (rows + 1) * cols;
         }
+    }
+
+    void Network::applyWeightNormUpdate()
+    {
+        if (!weightNorm)
+        {
+            return;
+        }
+
+        // The update just applied, dw (= deltaWeights), stands in for -eta * dL/dw. With
+        // u = v / |v| the chain rule gives dg = dw . u and dv = (g / |v|) (dw - dg u); the
+        // weights are then rebuilt as g * v / |v|.
+        thread_local std::vector<double> vv, dv, a, b;
+
+        double* block = weights;
+        const double* delta = deltaWeights;
+        double* v = weightNormDirections.data();
+        double* gains = weightNormGains.data();
+
+        for (std::size_t layerNum = 0; layerNum + 1 < topology.size(); ++layerNum)
+        {
+            const std::size_t rows = topology[layerNum];
+            const std::size_t cols = topology[layerNum + 1];
 
-        // Update connection weights for all layers from output to first hidden layer
+            vv.assign (cols, 0.0);
+            dv.assign (cols, 0.0);
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                const double* vRow = v + i * cols;
+                const double* dRow = delta + i * cols;
+                for (std::size_t n = 0; n < cols; ++n)
+                {
+                    vv[n] += vRow[n] * vRow[n];
+                    dv[n] += dRow[n] * vRow[n];
+                }
+            }
+
+            a.resize (cols);
+            b.resize (cols);
+            for (std::size_t n = 0; n < cols; ++n)
+            {
+                const double invNorm = vv[n] > 0.0 ? 1.0 / std::sqrt (vv[n]) : 0.0;
+                const double dg = dv[n] * invNorm;
+                a[n] = gains[n] * invNorm;
+                b[n] = a[n] * dg * invNorm;
+                gains[n] += dg;
+                vv[n] = 0.0;
+            }
+
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                double* vRow = v + i * cols;
+                const double* dRow = delta + i * cols;
+                for (std::size_t n = 0; n < cols; ++n)
+                {
+                    vRow[n] += a[n] * dRow[n] - b[n] * vRow[n];
+                    vv[n] += vRow[n] * vRow[n];
+                }
+            }
+
+            for (std::size_t n = 0; n < cols; ++n)
+            {
+                a[n] = vv[n] > 0.0 ? gains[n] / std::sqrt (vv[n]) : 0.0;
+            }
+
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                double* row = block + i * cols;
+                const double* vRow = v + i * cols;
+                for (std::size_t n = 0; n < cols; ++n)
+                {
+                    row[n] = a[n] * vRow[n];
+                }
+            }
+
+            const std::size_t layerSize = (rows + 1) * cols;
+            block += layerSize;
+            delta += layerSize;
+            v += layerSize;
+            gains += cols;
+        }
+    }
+
+    void Network::updateWeights()
+    {
+        invalidateCaches();
         for (std::size_t layerNum = layers.size() - 1; layerNum > 0; --layerNum)
         {
             Layer& layer = layers[layerNum];
@@ -122,75 +583,662 @@ namespace ML
 
             for (std::size_t n = 0; n < layer.size() - 1; ++n)
             {
-                layer[n]->updateInputWeights(prevLayer);
+                layer[n].updateInputWeights(prevLayer, learningRate, momentum);
             }
         }
+
+        applyWeightMask();
+        applyWeightNormUpdate();
     }
 
-    void Network::feedForward (std::vector<double> inputVals)
+    void Network::backPropagate (const std::vector<double>& targetVals)
+    {
+        backPropagateFrom (targetVals.data());
+    }
+
+    double Network::trainStep (const std::vector<double>& inputVals, const std::vector<double>& targetVals)
     {
         assert(inputVals.size() == layers[0].size() - 1);
+        assert(targetVals.size() == layers.back().size() - 1);
+        return trainStep (inputVals.data(), targetVals.data());
+    }
 
-        // Assign input values to input neurons
-        for (std::size_t i = 0; i < inputVals.size(); ++i)
+    double Network::trainStep (const double* inputVals, const double* targetVals)
+    {
+        writeDenseInputs (inputVals);
+
+        if (precision == Precision::Mixed)
+        {
+            feedForwardMixed();
+        }
+        else
         {
-            layers[0][i]->setOutputVal(inputVals[i]);
+            forwardDouble();
         }
 
-        // Forward propagate
-        for (std::size_t layerNum = 1; layerNum < layers.size(); ++layerNum)
+        backPropagateFrom (targetVals);
+        return error;
+    }
+
+    double Network::accumulateGradient (const double* inputVals, const double* targetVals, double* gradientSums)
+    {
+        writeDenseInputs (inputVals);
+        forwardDouble();
+        computeOutputGradients (targetVals);
+        backPropagateDouble (gradientSums);
+        return error;
+    }
+
+    void Network::applyGradient (const double* gradient)
+    {
+        invalidateCaches();
+        for (std::size_t i = 0; i < numWeights; ++i)
+        {
+            const double newDeltaWeight = learningRate * gradient[i] + momentum * deltaWeights[i];
+            deltaWeights[i] = newDeltaWeight;
+            weights[i] += newDeltaWeight;
+        }
+
+        applyWeightMask();
+        applyWeightNormUpdate();
+    }
+
+    void Network::computeOutputGradients (const double* targetVals)
+    {
+        Layer& outputLayer = layers.back();
+        error = computeLoss (loss, outputLayer.size() - 1, outputLayer.getOutputVals(), outputSums, targetVals,
+                             outputLayer.getGradients(), huberDelta);
+
+        // Implement a recent average measurement
+        recentAverageError = (recentAverageError * recentAverageSmoothingFactor + error) / (recentAverageSmoothingFactor + 1.0);
+    }
+
+    void Network::backPropagateFrom (const double* targetVals)
+    {
+        incrementalValid = false; // the Mixed working weights are kept in step below
+        ++weightsVersion;
+        computeOutputGradients (targetVals);
+
+        if (precision == Precision::Mixed)
+        {
+            backPropagateMixed();
+        }
+        else
+        {
+            backPropagateDouble (nullptr);
+        }
+
+        applyWeightMask();
+        applyWeightNormUpdate();
+
+        if (!weightMask.empty() || weightNorm)
+        {
+            workingWeightsValid = false; // the master weights moved again after the fused update
+        }
+    }
+
+    void Network::backPropagateDouble (double* gradientSums, const std::uint32_t* activeInputs, std::size_t numActive)
+    {
+        // The output layer gradients come from computeOutputGradients. With gradientSums
+        // the weight gradients are added there instead of being applied. Walk the weight
+        // blocks from the output down, one pass over each. A source neuron's row first gives
+        // its own gradient (the row dotted with the next layer's gradients, read before the
+        // update) and is then updated in place while still in cache. Rows go four at a time
+        // so the dot products overlap; each still sums in order.
+        for (std::size_t layerNum = layers.size() - 1; layerNum > 0; --layerNum)
         {
             Layer& prevLayer = layers[layerNum - 1];
-            for (std::size_t n = 0; n < layers[layerNum].size() - 1; ++n)
+            const double* layerGradients = layers[layerNum].getGradients();
+            const std::size_t numNeurons = prevLayer.getNumOutputs();
+            const std::size_t numPrev = prevLayer.size();
+            const double* prevVals = prevLayer.getOutputVals();
+            double* prevGradients = layerNum > 1 ? prevLayer.getGradients() : nullptr; // inputs need none
+
+            if (layerNum == 1 && activeInputs != nullptr)
             {
-                layers[layerNum][n]->feedForward(prevLayer);
+                // Sparse inputs: only the listed rows see a non-zero input, so only they move
+                for (std::size_t k = 0; k < numActive; ++k)
+                {
+                    const std::size_t i = activeInputs[k];
+                    double* row = prevLayer.getOutputWeights() + i * numNeurons;
+                    double* deltaRow = prevLayer.getDeltaWeights() + i * numNeurons;
+                    const double scaledOutput = learningRate * prevVals[i];
+
+                    for (std::size_t n = 0; n < numNeurons; ++n)
+                    {
+                        const double newDeltaWeight = scaledOutput * layerGradients[n] + momentum * deltaRow[n];
+                        deltaRow[n] = newDeltaWeight;
+                        row[n] += newDeltaWeight;
+                    }
+                }
+                continue;
+            }
+
+            for (std::size_t i0 = 0; i0 < numPrev; i0 += 4)
+            {
+                const std::size_t rows = std::min<std::size_t> (4, numPrev - i0);
+                double* block = prevLayer.getOutputWeights() + i0 * numNeurons;
+                double* deltaBlock = prevLayer.getDeltaWeights() + i0 * numNeurons;
+
+                if (prevGradients != nullptr)
+                {
+                    double dow[4] = {0.0, 0.0, 0.0, 0.0};
+                    if (rows == 4)
+                    {
+                        const double* r1 = block + numNeurons;
+                        const double* r2 = r1 + numNeurons;
+                        const double* r3 = r2 + numNeurons;
+                        for (std::size_t n = 0; n < numNeurons; ++n)
+                        {
+                            dow[0] += block[n] * layerGradients[n];
+                            dow[1] += r1[n] * layerGradients[n];
+                            dow[2] += r2[n] * layerGradients[n];
+                            dow[3] += r3[n] * layerGradients[n];
+                        }
+                    }
+                    else
+                    {
+                        for (std::size_t r = 0; r < rows; ++r)
+                        {
+                            for (std::size_t n = 0; n < numNeurons; ++n)
+                            {
+                                dow[r] += block[r * numNeurons + n] * layerGradients[n];
+                            }
+                        }
+                    }
+
+                    for (std::size_t r = 0; r < rows; ++r)
+                    {
+                        prevGradients[i0 + r] = dow[r] * Neuron::transferFunctionDerivative (prevVals[i0 + r]);
+                    }
+                }
+
+                if (gradientSums != nullptr)
+                {
+                    double* sumBlock = gradientSums + (block - weights);
+                    for (std::size_t r = 0; r < rows; ++r)
+                    {
+                        double* sumRow = sumBlock + r * numNeurons;
+                        const double output = prevVals[i0 + r];
+                        for (std::size_t n = 0; n < numNeurons; ++n)
+                        {
+                            sumRow[n] += output * layerGradients[n];
+                        }
+                    }
+                    continue;
+                }
+
+                for (std::size_t r = 0; r < rows; ++r)
+                {
+                    double* row = block + r * numNeurons;
+                    double* deltaRow = deltaBlock + r * numNeurons;
+                    const double scaledOutput = learningRate * prevVals[i0 + r];
+
+                    for (std::size_t n = 0; n < numNeurons; ++n)
+                    {
+                        const double newDeltaWeight = scaledOutput * layerGradients[n] + momentum * deltaRow[n];
+                        deltaRow[n] = newDeltaWeight;
+                        row[n] += newDeltaWeight;
+                    }
+                }
             }
         }
     }
 
-    void Network::getResults (std::vector<double>& resultVals) const
+    void Network::backPropagateMixed()
     {
-        resultVals.clear();
-        for (const auto& neuron : layers.back())
+        if (!workingWeightsValid)
+        {
+            std::copy_n (weights, numWeights, workingWeights.begin());
+        }
+
+        const std::size_t numLayers = layers.size();
+        auto weightOffset = [&] (std::size_t layerNum) { return static_cast<std::size_t> (layers[layerNum].getOutputWeights() - weights); };
+
+        // Output layer gradients, computed in double by computeOutputGradients
         {
-            if (&neuron != &layers.back().back()) // Ignore the bias neuron
+            const std::size_t numOutputs = layers.back().size() - 1;
+            const double* outputGradients = layers.back().getGradients();
+            std::copy_n (outputGradients, numOutputs, workingGradients.begin() + neuronOffsets[numLayers - 1]);
+        }
+
+        // Hidden layer gradients, accumulated in double
+        for (std::size_t layerNum = numLayers - 2; layerNum > 0; --layerNum)
+        {
+            const std::size_t numNeurons = layers[layerNum].size();
+            const std::size_t numNext = layers[layerNum].getNumOutputs();
+            const float* w = workingWeights.data() + weightOffset (layerNum);
+            const float* nextGradients = workingGradients.data() + neuronOffsets[layerNum + 1];
+            const float* hiddenVals = workingValues.data() + neuronOffsets[layerNum];
+            float* hiddenGradients = workingGradients.data() + neuronOffsets[layerNum];
+
+            for (std::size_t i = 0; i < numNeurons; ++i)
             {
-                resultVals.push_back(neuron->getOutputVal());
+                const float* row = w + i * numNext;
+                double dow = 0.0;
+                for (std::size_t n = 0; n < numNext; ++n)
+                {
+                    dow += static_cast<double> (row[n]) * nextGradients[n];
+                }
+                hiddenGradients[i] = static_cast<float> (dow * Neuron::transferFunctionDerivative (hiddenVals[i]));
+            }
+        }
+
+        // Update the double master weights and refresh their float copies in the same pass
+        for (std::size_t layerNum = numLayers - 1; layerNum > 0; --layerNum)
+        {
+            const std::size_t numPrev = layers[layerNum - 1].size();
+            const std::size_t numNeurons = layers[layerNum - 1].getNumOutputs();
+            const std::size_t offset = weightOffset (layerNum - 1);
+            const float* prevVals = workingValues.data() + neuronOffsets[layerNum - 1];
+            const float* layerGradients = workingGradients.data() + neuronOffsets[layerNum];
+
+            for (std::size_t i = 0; i < numPrev; ++i)
+            {
+                double* row = weights + offset + i * numNeurons;
+                double* deltaRow = deltaWeights + offset + i * numNeurons;
+                float* workingRow = workingWeights.data() + offset + i * numNeurons;
+                const double scaledOutput = learningRate * prevVals[i];
+
+                for (std::size_t n = 0; n < numNeurons; ++n)
+                {
+                    const double newDeltaWeight = scaledOutput * layerGradients[n] + momentum * deltaRow[n];
+                    deltaRow[n] = newDeltaWeight;
+                    row[n] += newDeltaWeight;
+                    workingRow[n] = static_cast<float> (row[n]);
+                }
             }
         }
+
+        workingWeightsValid = true;
     }
 
-    std::vector<double> Network::getWeights() const
+    void Network::setPrecision (Precision newPrecision)
+    {
+        precision = newPrecision;
+        prepareWorkingStorage();
+    }
+
+    void Network::prepareWorkingStorage()
     {
-        std::vector<double> weights;
+        workingWeightsValid = false;
 
+        if (precision != Precision::Mixed)
+        {
+            std::vector<float>().swap (workingWeights);
+            std::vector<float>().swap (workingValues);
+            std::vector<float>().swap (workingGradients);
+            return;
+        }
+
+        neuronOffsets.assign (1, 0);
         for (const Layer& layer : layers)
         {
-            for (const auto& neuron : layer)
+            neuronOffsets.push_back (neuronOffsets.back() + layer.size());
+        }
+
+        workingWeights.resize (numWeights);
+        workingValues.assign (neuronOffsets.back(), 0.0f);
+        workingGradients.assign (neuronOffsets.back(), 0.0f);
+    }
+
+    void Network::feedForwardMixed()
+    {
+        if (!workingWeightsValid)
+        {
+            std::copy_n (weights, numWeights, workingWeights.begin());
+            workingWeightsValid = true;
+        }
+
+        thread_local std::vector<double> sums;
+
+        const float* w = workingWeights.data();
+        std::copy_n (layers[0].getOutputVals(), layers[0].size(), workingValues.begin()); // inputs and bias
+
+        for (std::size_t layerNum = 1; layerNum < layers.size(); ++layerNum)
+        {
+            const std::size_t numInputs = layers[layerNum - 1].size();
+            const std::size_t numOutputs = layers[layerNum].size() - 1;
+            const float* in = workingValues.data() + neuronOffsets[layerNum - 1];
+            float* out = workingValues.data() + neuronOffsets[layerNum];
+            double* outputVals = layers[layerNum].getOutputVals();
+
+            // Float operands, double accumulators, same order as forwardLayer
+            sums.assign (numOutputs, 0.0);
+            for (std::size_t i = 0; i < numInputs; ++i)
             {
-                for (const auto& weight : neuron->getOutputWeights())
+                const double x = in[i];
+                const float* row = w + i * numOutputs;
+                for (std::size_t n = 0; n < numOutputs; ++n)
                 {
-                    weights.push_back(weight->weight);
+                    sums[n] += x * row[n];
                 }
             }
+
+            for (std::size_t n = 0; n < numOutputs; ++n)
+            {
+                out[n] = static_cast<float> (Neuron::transferFunction (sums[n]));
+                outputVals[n] = out[n]; // getResults and the Double passes see the same values
+            }
+            out[numOutputs] = static_cast<float> (outputVals[numOutputs]);
+
+            if (layerNum == layers.size() - 1)
+            {
+                std::copy_n (sums.begin(), numOutputs, outputSums);
+            }
+
+            w += numInputs * numOutputs;
+        }
+    }
+
+    void Network::feedForward (std::vector<double> inputVals)
+    {
+        assert(inputVals.size() == layers[0].size() - 1);
+
+        // Assign input values to input neurons
+        writeDenseInputs (inputVals.data());
+
+        if (precision == Precision::Mixed)
+        {
+            feedForwardMixed();
+            return;
         }
 
-        return weights;
+        forwardDouble();
     }
 
-    void Network::putWeights (const std::vector<double>& weights)
+    void Network::forwardDouble (std::size_t firstLayer)
     {
-        std::size_t cWeight = 0;
+        for (std::size_t layerNum = firstLayer; layerNum < layers.size(); ++layerNum)
+        {
+            const Layer& prevLayer = layers[layerNum - 1];
+            forwardLayer (prevLayer.getOutputVals(), prevLayer.size(), prevLayer.getOutputWeights(),
+                          layers[layerNum].size() - 1, layers[layerNum].getOutputVals(),
+                          layerNum == layers.size() - 1 ? outputSums : nullptr);
+        }
+    }
 
-        for (Layer& layer : layers)
+    void Network::writeDenseInputs (const double* inputVals)
+    {
+        std::copy_n (inputVals, layers[0].size() - 1, layers[0].getOutputVals());
+        sparseInputsClean = false;
+    }
+
+    void Network::feedForwardSparse (const SparseInput& input)
+    {
+        assert(input.indices.size() == input.values.size());
+        feedForwardSparse (input.indices.data(), input.values.data(), input.indices.size());
+    }
+
+    void Network::feedForwardSparse (const std::uint32_t* indices, const double* values, std::size_t count)
+    {
+        const std::size_t numInputs = layers[0].size() - 1;
+        double* inputs = layers[0].getOutputVals();
+
+        // The input neurons hold the dense equivalent, so backPropagate still works after
+        // this pass. Only the previous sparse pass's entries need clearing.
+        if (sparseInputsClean)
         {
-            for (auto& neuron : layer)
+            for (std::uint32_t i : sparseActive)
             {
-                for (auto& weight : neuron->getOutputWeights())
+                inputs[i] = 0.0;
+            }
+        }
+        else
+        {
+            std::fill_n (inputs, numInputs, 0.0);
+            sparseInputsClean = true;
+        }
+        sparseActive.assign (indices, indices + count);
+
+        // backPropagateMixed reads the float working values, so fill them all
+        if (precision == Precision::Mixed)
+        {
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                assert(indices[k] < numInputs);
+                inputs[indices[k]] = values[k];
+            }
+            feedForwardMixed();
+            return;
+        }
+
+        // First hidden layer: gather-sum the listed inputs' weight rows. The bias neuron
+        // outputs 0, so its row adds nothing.
+        const std::size_t numHidden = layers[1].size() - 1;
+        const double* firstWeights = layers[0].getOutputWeights();
+        double* hiddenVals = layers[1].getOutputVals();
+        std::fill_n (hiddenVals, numHidden, 0.0);
+
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            assert(indices[k] < numInputs);
+            const double x = values[k];
+            const double* row = firstWeights + static_cast<std::size_t> (indices[k]) * numHidden;
+            inputs[indices[k]] = x;
+            for (std::size_t n = 0; n < numHidden; ++n)
+            {
+                hiddenVals[n] += x * row[n];
+            }
+        }
+
+        if (layers.size() == 2)
+        {
+            std::copy_n (hiddenVals, numHidden, outputSums);
+        }
+        for (std::size_t n = 0; n < numHidden; ++n)
+        {
+            hiddenVals[n] = Neuron::transferFunction (hiddenVals[n]);
+        }
+
+        forwardDouble (2);
+    }
+
+    double Network::trainStepSparse (const SparseInput& input, const std::vector<double>& targetVals)
+    {
+        assert(input.indices.size() == input.values.size());
+        assert(targetVals.size() == layers.back().size() - 1);
+        return trainStepSparse (input.indices.data(), input.values.data(), input.indices.size(), targetVals.data());
+    }
+
+    double Network::trainStepSparse (const std::uint32_t* indices, const double* values, std::size_t count,
+                                     const double* targetVals)
+    {
+        // Weight norm rescales whole columns by their norm over every row, which no update
+        // of a few rows can keep up with
+        if (weightNorm)
+        {
+            std::cerr << "Error: trainStepSparse does not support weight normalisation\n";
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        feedForwardSparse (indices, values, count);
+
+        invalidateCaches(); // the Mixed working weights are not kept in step on this path
+        computeOutputGradients (targetVals);
+        backPropagateDouble (nullptr, indices, count);
+
+        applyWeightMask (indices, count);
+        return error;
+    }
+
+    void Network::feedForwardIncremental (const std::vector<double>& inputVals)
+    {
+        assert(inputVals.size() == layers[0].size() - 1);
+
+        if (precision == Precision::Mixed)
+        {
+            feedForward (inputVals);
+            return;
+        }
+
+        // Rounding error builds up in the running sums, so rebuild them from scratch now and then
+        constexpr unsigned refreshInterval = 1024;
+
+        const std::size_t numInputs = inputVals.size();
+        const std::size_t numHidden = layers[1].size() - 1;
+        const double* firstWeights = layers[0].getOutputWeights();
+
+        std::size_t numChanged = 0;
+        if (incrementalValid)
+        {
+            for (std::size_t i = 0; i < numInputs; ++i)
+            {
+                numChanged += inputVals[i] != incrementalInputs[i];
+            }
+        }
+
+        if (!incrementalValid || incrementalUpdates + numChanged > refreshInterval || 2 * numChanged > numInputs)
+        {
+            // Full rebuild, bias neuron included, in the same order as forwardLayer
+            incrementalInputs = inputVals;
+            incrementalSums.assign (numHidden, 0.0);
+            for (std::size_t i = 0; i <= numInputs; ++i)
+            {
+                const double x = i < numInputs ? inputVals[i] : layers[0].getOutputVals()[numInputs];
+                const double* row = firstWeights + i * numHidden;
+                for (std::size_t n = 0; n < numHidden; ++n)
                 {
-                    weight->weight = weights[cWeight++];
+                    incrementalSums[n] += x * row[n];
                 }
             }
+            incrementalValid = true;
+            incrementalUpdates = 0;
         }
+        else
+        {
+            for (std::size_t i = 0; i < numInputs && numChanged > 0; ++i)
+            {
+                const double delta = inputVals[i] - incrementalInputs[i];
+                if (delta == 0.0)
+                {
+                    continue;
+                }
+
+                const double* row = firstWeights + i * numHidden;
+                for (std::size_t n = 0; n < numHidden; ++n)
+                {
+                    incrementalSums[n] += delta * row[n];
+                }
+                incrementalInputs[i] = inputVals[i];
+                --numChanged;
+                ++incrementalUpdates;
+            }
+        }
+
+        // Input neurons still need their values for backPropagate
+        writeDenseInputs (inputVals.data());
+
+        double* hiddenVals = layers[1].getOutputVals();
+        for (std::size_t n = 0; n < numHidden; ++n)
+        {
+            hiddenVals[n] = Neuron::transferFunction (incrementalSums[n]);
+        }
+
+        if (layers.size() == 2)
+        {
+            std::copy_n (incrementalSums.begin(), numHidden, outputSums);
+        }
+
+        for (std::size_t layerNum = 2; layerNum < layers.size(); ++layerNum)
+        {
+            const Layer& prevLayer = layers[layerNum - 1];
+            forwardLayer (prevLayer.getOutputVals(), prevLayer.size(), prevLayer.getOutputWeights(),
+                          layers[layerNum].size() - 1, layers[layerNum].getOutputVals(),
+                          layerNum == layers.size() - 1 ? outputSums : nullptr);
+        }
+    }
+
+    void Network::feedForward (const std::vector<unsigned>& topology, const double* weights,
+                               const double* inputVals, double* resultVals)
+    {
+        thread_local std::vector<double> scratch;
+
+        const std::size_t widest = *std::max_element (topology.begin(), topology.end()) + 1;
+        scratch.resize (2 * widest);
+        double* in = scratch.data();
+        double* out = in + widest;
+
+        std::copy_n (inputVals, topology.front(), in);
+        in[topology.front()] = 0.0; // bias neuron
+
+        for (std::size_t layerNum = 1; layerNum < topology.size(); ++layerNum)
+        {
+            const std::size_t numInputs = topology[layerNum - 1] + 1;
+            const std::size_t numOutputs = topology[layerNum];
+            forwardLayer (in, numInputs, weights, numOutputs, out);
+            out[numOutputs] = 0.0;
+
+            weights += numInputs * numOutputs;
+            std::swap (in, out);
+        }
+
+        std::copy_n (in, topology.back(), resultVals);
+    }
+
+    void Network::feedForwardBatch (const std::vector<unsigned>& topology, const double* weights,
+                                    const double* inputVals, std::size_t batchSize, double* resultVals, double* resultSums)
+    {
+        thread_local std::vector<double> scratch;
+
+        // Each sample's activations carry a trailing bias slot, so layer l has stride topology[l] + 1
+        const std::size_t widest = *std::max_element (topology.begin(), topology.end()) + 1;
+        scratch.resize (2 * widest * batchSize);
+        double* in = scratch.data();
+        double* out = in + widest * batchSize;
+
+        const std::size_t numInputs = topology.front();
+        for (std::size_t b = 0; b < batchSize; ++b)
+        {
+            std::copy_n (inputVals + b * numInputs, numInputs, in + b * (numInputs + 1));
+            in[b * (numInputs + 1) + numInputs] = 0.0; // bias neuron
+        }
+
+        for (std::size_t layerNum = 1; layerNum < topology.size(); ++layerNum)
+        {
+            const std::size_t layerInputs = topology[layerNum - 1] + 1;
+            const std::size_t layerOutputs = topology[layerNum];
+            forwardLayerBatch (in, layerInputs, layerInputs, weights, layerOutputs, out, layerOutputs + 1, batchSize,
+                               layerNum == topology.size() - 1 ? resultSums : nullptr);
+
+            for (std::size_t b = 0; b < batchSize; ++b)
+            {
+                out[b * (layerOutputs + 1) + layerOutputs] = 0.0;
+            }
+
+            weights += layerInputs * layerOutputs;
+            std::swap (in, out);
+        }
+
+        const std::size_t numOutputs = topology.back();
+        for (std::size_t b = 0; b < batchSize; ++b)
+        {
+            std::copy_n (in + b * (numOutputs + 1), numOutputs, resultVals + b * numOutputs);
+        }
+    }
+
+    void Network::getResults (std::vector<double>& resultVals) const
+    {
+        const Layer& outputLayer = layers.back();
+        resultVals.assign (outputLayer.getOutputVals(), outputLayer.getOutputVals() + outputLayer.size() - 1); // Ignore the bias neuron
+    }
+
+    void Network::getPredictions (std::vector<double>& predictionVals) const
+    {
+        const Layer& outputLayer = layers.back();
+        predictionVals.resize (outputLayer.size() - 1);
+        computePredictions (loss, predictionVals.size(), outputLayer.getOutputVals(), outputSums, predictionVals.data());
+    }
+
+    std::vector<double> Network::getWeights() const
+    {
+        return std::vector<double> (weights, weights + numWeights);
+    }
+
+    void Network::putWeights (const std::vector<double>& newWeights)
+    {
+        invalidateCaches();
+        std::copy_n (newWeights.begin(), std::min (newWeights.size(), numWeights), weights);
+        syncWeightNorm();
     }
 }
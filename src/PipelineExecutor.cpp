@@ -0,0 +1,165 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "PipelineExecutor.h"
+#include "Gemm.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ML
+{
+    PipelineExecutor::PipelineExecutor (const Network& network, unsigned numStages, std::size_t queueCapacity)
+        : topology (network.getTopology()),
+          weights (network.getWeights())
+    {
+        const std::size_t numWeightLayers = topology.size() - 1;
+        weightOffsets = Network::layerWeightOffsets (topology);
+
+        if (numStages == 0)
+        {
+            numStages = defaultThreadCount();
+        }
+        numStages = static_cast<unsigned> (std::min<std::size_t> (std::max (numStages, 1u), numWeightLayers));
+
+        // Cut where the running weight count crosses each multiple of total / numStages,
+        // keeping at least one layer per stage
+        std::vector<std::size_t> boundaries (1, 1);
+        for (unsigned s = 1; s < numStages; ++s)
+        {
+            const double target = static_cast<double> (weightOffsets.back()) * s / numStages;
+            std::size_t layer = boundaries.back() + 1;
+            while (layer < numWeightLayers + 1 - (numStages - s) && static_cast<double> (weightOffsets[layer - 1]) < target)
+            {
+                ++layer;
+            }
+            boundaries.push_back (layer);
+        }
+        boundaries.push_back (topology.size());
+
+        for (unsigned s = 0; s < numStages; ++s)
+        {
+            auto stage = std::make_unique<Stage>();
+            stage->firstLayer = boundaries[s];
+            stage->lastLayer = boundaries[s + 1];
+            stage->input = std::make_unique<SpscQueue<std::unique_ptr<Job>>> (queueCapacity);
+            stages.push_back (std::move (stage));
+        }
+
+        for (std::size_t s = 0; s < stages.size(); ++s)
+        {
+            stages[s]->thread = std::thread (&PipelineExecutor::run, this, s);
+        }
+    }
+
+    PipelineExecutor::~PipelineExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock (submitMutex);
+            stopping.store (true, std::memory_order_release);
+        }
+
+        for (auto& stage : stages)
+        {
+            stage->thread.join();
+        }
+    }
+
+    std::future<std::vector<double>> PipelineExecutor::submit (std::vector<double> inputVals)
+    {
+        auto job = std::make_unique<Job>();
+        std::future<std::vector<double>> result = job->result.get_future();
+
+        if (inputVals.size() != topology.front())
+        {
+            job->result.set_exception (std::make_exception_ptr (std::invalid_argument ("Input size does not match the model")));
+            return result;
+        }
+
+        job->activations = std::move (inputVals);
+        job->activations.push_back (0.0); // bias neuron
+
+        std::lock_guard<std::mutex> lock (submitMutex);
+        Backoff backoff;
+        while (!stages.front()->input->tryPush (job))
+        {
+            backoff.wait();
+        }
+
+        return result;
+    }
+
+    std::vector<std::size_t> PipelineExecutor::getStageBoundaries() const
+    {
+        std::vector<std::size_t> boundaries;
+        for (const auto& stage : stages)
+        {
+            boundaries.push_back (stage->firstLayer);
+        }
+        return boundaries;
+    }
+
+    void PipelineExecutor::run (std::size_t stageNum)
+    {
+        Stage& stage = *stages[stageNum];
+        SpscQueue<std::unique_ptr<Job>>* output = stageNum + 1 < stages.size() ? stages[stageNum + 1]->input.get() : nullptr;
+        std::vector<double> scratch;
+        Backoff backoff;
+
+        for (;;)
+        {
+            std::unique_ptr<Job> job;
+            if (!stage.input->tryPop (job))
+            {
+                // Upstream must be finished before the last look at the queue, or a job could slip past
+                const bool upstreamDone = stageNum == 0 ? stopping.load (std::memory_order_acquire)
+                                                        : stages[stageNum - 1]->finished.load (std::memory_order_acquire);
+                if (upstreamDone && !stage.input->tryPop (job))
+                {
+                    break;
+                }
+                if (!job)
+                {
+                    backoff.wait();
+                    continue;
+                }
+            }
+            backoff.reset();
+
+            // Same kernel as Network's forward pass, so results match it exactly
+            for (std::size_t layerNum = stage.firstLayer; layerNum < stage.lastLayer; ++layerNum)
+            {
+                const std::size_t numInputs = topology[layerNum - 1] + 1;
+                const std::size_t numOutputs = topology[layerNum];
+                scratch.resize (numOutputs + 1);
+                gemvT (numInputs, numOutputs, weights.data() + weightOffsets[layerNum - 1], numOutputs,
+                       job->activations.data(), 0.0, scratch.data());
+                for (std::size_t n = 0; n < numOutputs; ++n)
+                {
+                    scratch[n] = Neuron::transferFunction (scratch[n]);
+                }
+                scratch[numOutputs] = 0.0;
+                std::swap (scratch, job->activations);
+            }
+
+            if (output == nullptr)
+            {
+                job->activations.pop_back();
+                job->result.set_value (std::move (job->activations));
+                continue;
+            }
+
+            while (!output->tryPush (job))
+            {
+                backoff.wait();
+            }
+            backoff.reset();
+        }
+
+        stage.finished.store (true, std::memory_order_release);
+    }
+}
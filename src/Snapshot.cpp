@@ -0,0 +1,130 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "Snapshot.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace ML
+{
+    namespace
+    {
+        constexpr std::size_t maxSpareSnapshots = 2;
+    }
+
+    SnapshotPublisher::SnapshotPublisher (std::size_t maxReaders)
+        : slots (new ReaderSlot[std::max<std::size_t> (maxReaders, 1)]), numSlots (std::max<std::size_t> (maxReaders, 1))
+    {
+    }
+
+    SnapshotPublisher::~SnapshotPublisher()
+    {
+        delete current.load();
+    }
+
+    std::uint64_t SnapshotPublisher::publish (const Network& network)
+    {
+        return publish (network.getTopology(), network.getWeightData());
+    }
+
+    std::uint64_t SnapshotPublisher::publish (const std::vector<unsigned>& topology, const double* weights)
+    {
+        std::lock_guard<std::mutex> lock (publishMutex);
+
+        std::unique_ptr<WeightSnapshot> next;
+        if (!spare.empty())
+        {
+            next = std::move (spare.back());
+            spare.pop_back();
+        }
+        else
+        {
+            next = std::make_unique<WeightSnapshot>();
+        }
+
+        const std::size_t numWeights = Network::countWeights (topology);
+
+        // Reuses the recycled snapshot's capacity, so this only allocates while warming up
+        next->topology.assign (topology.begin(), topology.end());
+        next->weights.assign (weights, weights + numWeights);
+        next->version = nextVersion++;
+        const std::uint64_t version = next->version;
+
+        WeightSnapshot* old = current.exchange (next.release());
+        if (old != nullptr)
+        {
+            // Readers that entered at or before this epoch may still hold the old snapshot
+            retired.emplace_back (epoch.fetch_add (1), std::unique_ptr<WeightSnapshot> (old));
+        }
+
+        reclaim();
+        return version;
+    }
+
+    SnapshotPublisher::ReadGuard SnapshotPublisher::acquire() const
+    {
+        const std::size_t start = std::hash<std::thread::id>() (std::this_thread::get_id()) % numSlots;
+
+        for (;;)
+        {
+            for (std::size_t k = 0; k < numSlots; ++k)
+            {
+                std::atomic<std::uint64_t>& slot = slots[(start + k) % numSlots].epoch;
+                std::uint64_t expected = 0;
+
+                if (slot.load (std::memory_order_relaxed) == 0 && slot.compare_exchange_strong (expected, epoch.load()))
+                {
+                    return ReadGuard (&slot, current.load());
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    std::size_t SnapshotPublisher::getNumRetired() const
+    {
+        std::lock_guard<std::mutex> lock (publishMutex);
+        return retired.size();
+    }
+
+    void SnapshotPublisher::reclaim()
+    {
+        std::uint64_t oldestActive = std::numeric_limits<std::uint64_t>::max();
+        for (std::size_t i = 0; i < numSlots; ++i)
+        {
+            const std::uint64_t readerEpoch = slots[i].epoch.load();
+            if (readerEpoch != 0)
+            {
+                oldestActive = std::min (oldestActive, readerEpoch);
+            }
+        }
+
+        auto stillReferenced = retired.begin();
+        for (auto it = retired.begin(); it != retired.end(); ++it)
+        {
+            if (it->first < oldestActive)
+            {
+                if (spare.size() < maxSpareSnapshots)
+                {
+                    spare.push_back (std::move (it->second));
+                }
+            }
+            else
+            {
+                if (stillReferenced != it)
+                {
+                    *stillReferenced = std::move (*it);
+                }
+                ++stillReferenced;
+            }
+        }
+        retired.erase (stillReferenced, retired.end());
+    }
+}
@@ -0,0 +1,364 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "Sparse.h"
+#include "Gemm.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+namespace ML
+{
+    namespace
+    {
+        std::vector<unsigned char> currentMask (const Network& network)
+        {
+            const std::vector<unsigned char>& mask = network.getWeightMask();
+            return mask.empty() ? std::vector<unsigned char> (network.getNumWeights(), 1) : mask;
+        }
+
+        // Mask the `count` smallest-magnitude weights in [begin, end)
+        void maskSmallest (const double* weights, std::size_t begin, std::size_t end, std::size_t count,
+                           std::vector<unsigned char>& mask)
+        {
+            std::vector<std::size_t> order (end - begin);
+            std::iota (order.begin(), order.end(), begin);
+
+            count = std::min (count, order.size());
+            std::nth_element (order.begin(), order.begin() + count, order.end(), [&] (std::size_t a, std::size_t b)
+            {
+                const double magA = mask[a] ? std::abs (weights[a]) : 0.0;
+                const double magB = mask[b] ? std::abs (weights[b]) : 0.0;
+                return magA < magB || (magA == magB && a < b);
+            });
+
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                mask[order[k]] = 0;
+            }
+        }
+
+        std::size_t countPruned (const std::vector<unsigned char>& mask)
+        {
+            return static_cast<std::size_t> (std::count (mask.begin(), mask.end(), 0));
+        }
+
+        void denseLayer (const double* in, std::size_t numInputs, const double* w, std::size_t numOutputs, double* out)
+        {
+            gemvT (numInputs, numOutputs, w, numOutputs, in, 0.0, out);
+        }
+
+        void csrLayer (const double* in, const std::uint32_t* rowStart, const std::uint32_t* columns, const double* values,
+                       std::size_t numOutputs, double* out)
+        {
+            for (std::size_t n = 0; n < numOutputs; ++n)
+            {
+                double sum = 0.0;
+                for (std::uint32_t k = rowStart[n]; k < rowStart[n + 1]; ++k)
+                {
+                    sum += in[columns[k]] * values[k];
+                }
+                out[n] = sum;
+            }
+        }
+    }
+
+    std::size_t pruneByMagnitude (Network& network, double sparsity, PruneScope scope)
+    {
+        assert (sparsity >= 0.0 && sparsity <= 1.0);
+
+        std::vector<unsigned char> mask = currentMask (network);
+        const double* weights = network.getWeightData();
+        const std::vector<std::size_t> offsets = Network::layerWeightOffsets (network.getTopology());
+
+        if (scope == PruneScope::Global)
+        {
+            maskSmallest (weights, 0, offsets.back(), static_cast<std::size_t> (sparsity * offsets.back() + 0.5), mask);
+        }
+        else
+        {
+            for (std::size_t layerNum = 0; layerNum + 1 < offsets.size(); ++layerNum)
+            {
+                const std::size_t layerSize = offsets[layerNum + 1] - offsets[layerNum];
+                maskSmallest (weights, offsets[layerNum], offsets[layerNum + 1],
+                              static_cast<std::size_t> (sparsity * layerSize + 0.5), mask);
+            }
+        }
+
+        const std::size_t pruned = countPruned (mask);
+        network.setWeightMask (std::move (mask));
+        return pruned;
+    }
+
+    std::size_t pruneByThreshold (Network& network, double threshold)
+    {
+        std::vector<unsigned char> mask = currentMask (network);
+        const double* weights = network.getWeightData();
+
+        for (std::size_t i = 0; i < mask.size(); ++i)
+        {
+            if (std::abs (weights[i]) < threshold)
+            {
+                mask[i] = 0;
+            }
+        }
+
+        const std::size_t pruned = countPruned (mask);
+        network.setWeightMask (std::move (mask));
+        return pruned;
+    }
+
+    void pruneAndRetrain (Network& network, double finalSparsity, unsigned numSteps,
+                          const std::function<void (Network&)>& retrain, PruneScope scope)
+    {
+        for (unsigned step = 1; step <= numSteps; ++step)
+        {
+            pruneByMagnitude (network, finalSparsity * step / numSteps, scope);
+            retrain (network);
+        }
+    }
+
+    SparseNetwork::SparseNetwork (const Network& network, double breakEvenDensity)
+        : topology (network.getTopology())
+    {
+        const double* weights = network.getWeightData();
+        for (std::size_t layerNum = 0; layerNum + 1 < topology.size(); ++layerNum)
+        {
+            const std::size_t numInputs = topology[layerNum] + 1;
+            const std::size_t numOutputs = topology[layerNum + 1];
+            layers.push_back (compress (weights, numInputs, numOutputs, breakEvenDensity));
+            weights += numInputs * numOutputs;
+        }
+    }
+
+    SparseNetwork::SparseLayer SparseNetwork::compress (const double* weights, std::size_t numInputs, std::size_t numOutputs,
+                                                        double breakEvenDensity)
+    {
+        SparseLayer layer;
+        layer.numInputs = numInputs;
+        layer.numOutputs = numOutputs;
+
+        const std::size_t total = numInputs * numOutputs;
+        const std::size_t nonZeros = total - static_cast<std::size_t> (std::count (weights, weights + total, 0.0));
+        layer.density = total > 0 ? static_cast<double> (nonZeros) / static_cast<double> (total) : 1.0;
+        layer.sparse = layer.density < breakEvenDensity;
+
+        if (!layer.sparse)
+        {
+            layer.dense.assign (weights, weights + total);
+            return layer;
+        }
+
+        layer.rowStart.reserve (numOutputs + 1);
+        layer.columns.reserve (nonZeros);
+        layer.values.reserve (nonZeros);
+        layer.rowStart.push_back (0);
+
+        for (std::size_t n = 0; n < numOutputs; ++n)
+        {
+            for (std::size_t i = 0; i < numInputs; ++i)
+            {
+                const double w = weights[i * numOutputs + n];
+                if (w != 0.0)
+                {
+                    layer.columns.push_back (static_cast<std::uint32_t> (i));
+                    layer.values.push_back (w);
+                }
+            }
+            layer.rowStart.push_back (static_cast<std::uint32_t> (layer.values.size()));
+        }
+
+        return layer;
+    }
+
+    std::vector<double> SparseNetwork::feedForward (const std::vector<double>& inputVals) const
+    {
+        assert (inputVals.size() == topology.front());
+        std::vector<double> resultVals (topology.back());
+        feedForward (inputVals.data(), resultVals.data());
+        return resultVals;
+    }
+
+    void SparseNetwork::feedForward (const double* inputVals, double* resultVals) const
+    {
+        thread_local std::vector<double> scratch;
+
+        const std::size_t widest = *std::max_element (topology.begin(), topology.end()) + 1;
+        scratch.resize (2 * widest);
+        double* in = scratch.data();
+        double* out = in + widest;
+
+        std::copy_n (inputVals, topology.front(), in);
+        in[topology.front()] = 0.0; // bias neuron
+
+        for (const SparseLayer& layer : layers)
+        {
+            if (layer.sparse)
+            {
+                csrLayer (in, layer.rowStart.data(), layer.columns.data(), layer.values.data(), layer.numOutputs, out);
+            }
+            else
+            {
+                denseLayer (in, layer.numInputs, layer.dense.data(), layer.numOutputs, out);
+            }
+
+            for (std::size_t n = 0; n < layer.numOutputs; ++n)
+            {
+                out[n] = Neuron::transferFunction (out[n]);
+            }
+            out[layer.numOutputs] = 0.0;
+            std::swap (in, out);
+        }
+
+        std::copy_n (in, topology.back(), resultVals);
+    }
+
+    void SparseNetwork::feedForwardBatch (const double* inputVals, std::size_t batchSize, double* resultVals) const
+    {
+        thread_local std::vector<double> scratch;
+
+        // Activations are kept feature-major (in[i * batchSize + b]) so every kernel's inner
+        // loop runs contiguously across the batch: an SpMM that vectorises over samples.
+        const std::size_t widest = *std::max_element (topology.begin(), topology.end()) + 1;
+        scratch.resize (2 * widest * batchSize);
+        double* in = scratch.data();
+        double* out = in + widest * batchSize;
+
+        const std::size_t numInputs = topology.front();
+        for (std::size_t b = 0; b < batchSize; ++b)
+        {
+            for (std::size_t i = 0; i < numInputs; ++i)
+            {
+                in[i * batchSize + b] = inputVals[b * numInputs + i];
+            }
+        }
+        std::fill_n (in + numInputs * batchSize, batchSize, 0.0); // bias neuron
+
+        for (const SparseLayer& layer : layers)
+        {
+            std::fill_n (out, layer.numOutputs * batchSize, 0.0);
+
+            if (layer.sparse)
+            {
+                for (std::size_t n = 0; n < layer.numOutputs; ++n)
+                {
+                    double* sums = out + n * batchSize;
+                    for (std::uint32_t k = layer.rowStart[n]; k < layer.rowStart[n + 1]; ++k)
+                    {
+                        const double* x = in + layer.columns[k] * batchSize;
+                        const double w = layer.values[k];
+                        for (std::size_t b = 0; b < batchSize; ++b)
+                        {
+                            sums[b] += x[b] * w;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < layer.numInputs; ++i)
+                {
+                    const double* x = in + i * batchSize;
+                    const double* row = layer.dense.data() + i * layer.numOutputs;
+                    for (std::size_t n = 0; n < layer.numOutputs; ++n)
+                    {
+                        double* sums = out + n * batchSize;
+                        const double w = row[n];
+                        for (std::size_t b = 0; b < batchSize; ++b)
+                        {
+                            sums[b] += x[b] * w;
+                        }
+                    }
+                }
+            }
+
+            for (std::size_t k = 0; k < layer.numOutputs * batchSize; ++k)
+            {
+                out[k] = Neuron::transferFunction (out[k]);
+            }
+            std::fill_n (out + layer.numOutputs * batchSize, batchSize, 0.0);
+            std::swap (in, out);
+        }
+
+        const std::size_t numOutputs = topology.back();
+        for (std::size_t b = 0; b < batchSize; ++b)
+        {
+            for (std::size_t n = 0; n < numOutputs; ++n)
+            {
+                resultVals[b * numOutputs + n] = in[n * batchSize + b];
+            }
+        }
+    }
+
+    double SparseNetwork::getBreakEvenDensity()
+    {
+        static const double measured = measureBreakEvenDensity();
+        return measured;
+    }
+
+    double SparseNetwork::measureBreakEvenDensity (unsigned numInputs, unsigned numOutputs)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const double densities[] = { 0.02, 0.05, 0.1, 0.15, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9 };
+        constexpr int repetitions = 16;
+        constexpr int rounds = 3;
+
+        Random rng (0x5EED);
+        std::vector<double> in (numInputs + 1), out (numOutputs), weights (static_cast<std::size_t> (numInputs + 1) * numOutputs);
+        for (double& x : in)
+        {
+            x = rng.uniform (-1.0, 1.0);
+        }
+
+        double breakEven = 0.0;
+        double sink = 0.0;
+
+        for (double density : densities)
+        {
+            for (double& w : weights)
+            {
+                w = rng.nextDouble() < density ? rng.uniform (-1.0, 1.0) : 0.0;
+            }
+            const SparseLayer layer = compress (weights.data(), numInputs + 1, numOutputs, 2.0);
+
+            auto bestOf = [&] (auto&& kernel)
+            {
+                double best = 1e300;
+                for (int round = 0; round < rounds; ++round)
+                {
+                    const Clock::time_point start = Clock::now();
+                    for (int rep = 0; rep < repetitions; ++rep)
+                    {
+                        kernel();
+                        sink += out[rep % numOutputs];
+                    }
+                    best = std::min (best, std::chrono::duration<double> (Clock::now() - start).count());
+                }
+                return best;
+            };
+
+            const double denseTime = bestOf ([&] { denseLayer (in.data(), numInputs + 1, weights.data(), numOutputs, out.data()); });
+            const double sparseTime = bestOf ([&] { csrLayer (in.data(), layer.rowStart.data(), layer.columns.data(),
+                                                              layer.values.data(), numOutputs, out.data()); });
+
+            if (sparseTime >= denseTime)
+            {
+                break;
+            }
+            breakEven = density;
+        }
+
+        // Keep the timed work observable so it cannot be optimised away
+        volatile double keep = sink;
+        (void) keep;
+
+        return breakEven;
+    }
+}
@@ -0,0 +1,210 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+#include "Sweep.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+namespace ML
+{
+    namespace
+    {
+        const char* toString (WeightInit init)
+        {
+            switch (init)
+            {
+                case WeightInit::Xavier: return "Xavier";
+                case WeightInit::He:     return "He";
+                default:                 return "Uniform";
+            }
+        }
+
+        std::string toString (const std::vector<unsigned>& topology)
+        {
+            std::string text;
+            for (unsigned layerSize : topology)
+            {
+                text += (text.empty() ? "" : "-") + std::to_string (layerSize);
+            }
+            return text;
+        }
+
+        SweepResult train (std::size_t configIndex, const SweepConfig& config, const std::vector<Sample>& dataset)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            SweepResult result;
+            result.configIndex = configIndex;
+            result.config = config;
+            result.bestError = std::numeric_limits<double>::infinity();
+
+            Models::Perceptron perceptron (config.topology, config.init, config.seed);
+            perceptron.setLearningRate (config.learningRate);
+            perceptron.setMomentum (config.momentum);
+            const Network& network = *perceptron.getNetwork();
+            unsigned epochsSinceImprovement = 0;
+
+            while (result.epochs < config.maxEpochs)
+            {
+                double epochError = 0.0;
+                for (const auto& [input, target] : dataset)
+                {
+                    perceptron.trainStep (input, target);
+                    epochError += network.getRecentAverageError();
+                }
+                epochError /= static_cast<double> (std::max<std::size_t> (dataset.size(), 1));
+
+                ++result.epochs;
+                result.finalError = epochError;
+
+                if (epochError < result.bestError - config.minImprovement)
+                {
+                    result.bestError = epochError;
+                    epochsSinceImprovement = 0;
+                }
+                else
+                {
+                    result.bestError = std::min (result.bestError, epochError);
+                    ++epochsSinceImprovement;
+                }
+
+                if (epochError <= config.targetError)
+                {
+                    result.status = SweepStatus::Converged;
+                    break;
+                }
+                if (config.patience > 0 && epochsSinceImprovement >= config.patience)
+                {
+                    result.status = SweepStatus::Plateaued;
+                    break;
+                }
+            }
+
+            result.weights = perceptron.getWeights();
+            result.seconds = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+    }
+
+    const char* toString (SweepStatus status)
+    {
+        switch (status)
+        {
+            case SweepStatus::Converged: return "converged";
+            case SweepStatus::Plateaued: return "plateaued";
+            default:                     return "max epochs";
+        }
+    }
+
+    std::vector<SweepConfig> makeSweepGrid (const std::vector<std::vector<unsigned>>& topologies,
+                                            const std::vector<WeightInit>& inits,
+                                            const std::vector<std::uint64_t>& seeds,
+                                            const SweepConfig& base)
+    {
+        return makeSweepGrid (topologies, inits, seeds, {base.learningRate}, {base.momentum}, base);
+    }
+
+    std::vector<SweepConfig> makeSweepGrid (const std::vector<std::vector<unsigned>>& topologies,
+                                            const std::vector<WeightInit>& inits,
+                                            const std::vector<std::uint64_t>& seeds,
+                                            const std::vector<double>& learningRates,
+                                            const std::vector<double>& momenta,
+                                            const SweepConfig& base)
+    {
+        std::vector<SweepConfig> configs;
+        configs.reserve (topologies.size() * inits.size() * seeds.size() * learningRates.size() * momenta.size());
+
+        for (const auto& topology : topologies)
+        {
+            for (WeightInit init : inits)
+            {
+                for (double learningRate : learningRates)
+                {
+                    for (double momentum : momenta)
+                    {
+                        for (std::uint64_t seed : seeds)
+                        {
+                            SweepConfig config = base;
+                            config.topology = topology;
+                            config.init = init;
+                            config.learningRate = learningRate;
+                            config.momentum = momentum;
+                            config.seed = seed;
+                            configs.push_back (std::move (config));
+                        }
+                    }
+                }
+            }
+        }
+
+        return configs;
+    }
+
+    std::vector<SweepResult> runSweep (const std::vector<SweepConfig>& configs, const std::vector<Sample>& dataset,
+                                       unsigned numThreads)
+    {
+        for (std::size_t c = 0; c < configs.size(); ++c)
+        {
+            const std::vector<unsigned>& topology = configs[c].topology;
+            for (const auto& [input, target] : dataset)
+            {
+                if (topology.size() < 2 || input.size() != topology.front() || target.size() != topology.back())
+                {
+                    std::cerr << "Error: Sweep config " << c << " (" << toString (topology)
+                              << ") does not match the dataset's input and target sizes\n";
+                    return {};
+                }
+            }
+        }
+
+        // Longest first: weights times epochs is a fair proxy for a config's cost
+        std::vector<std::size_t> order (configs.size());
+        std::iota (order.begin(), order.end(), 0);
+        auto cost = [&] (std::size_t c)
+        {
+            return static_cast<double> (Network::requiredBytes (configs[c].topology)) * configs[c].maxEpochs;
+        };
+        std::stable_sort (order.begin(), order.end(), [&] (std::size_t a, std::size_t b) { return cost (a) > cost (b); });
+
+        std::vector<SweepResult> results (configs.size());
+        parallelFor (order.size(), [&] (std::size_t k)
+        {
+            const std::size_t c = order[k];
+            results[c] = train (c, configs[c], dataset);
+        }, numThreads);
+
+        return results;
+    }
+
+    std::string formatSweepTable (const std::vector<SweepResult>& results)
+    {
+        std::ostringstream out;
+        out << std::left << std::setw (6) << "#" << std::setw (16) << "topology" << std::setw (9) << "init"
+            << std::setw (22) << "seed" << std::right << std::setw (8) << "lr" << std::setw (10) << "momentum"
+            << std::setw (8) << "epochs" << std::setw (14) << "final error"
+            << std::setw (14) << "best error" << std::setw (12) << "status" << std::setw (10) << "ms" << "\n";
+
+        for (const SweepResult& result : results)
+        {
+            out << std::left << std::setw (6) << result.configIndex << std::setw (16) << toString (result.config.topology)
+                << std::setw (9) << toString (result.config.init) << std::setw (22) << result.config.seed << std::right
+                << std::setw (8) << result.config.learningRate << std::setw (10) << result.config.momentum
+                << std::setw (8) << result.epochs << std::scientific << std::setprecision (4)
+                << std::setw (14) << result.finalError << std::setw (14) << result.bestError
+                << std::setw (12) << toString (result.status) << std::fixed << std::setprecision (1)
+                << std::setw (10) << result.seconds * 1000.0 << std::defaultfloat << "\n";
+        }
+
+        return out.str();
+    }
+}
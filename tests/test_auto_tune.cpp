@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "AutoTune.h"
+#include "Network.h"
+#include "Random.h"
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    fs::path makeTempDirectory(const std::string& name)
+    {
+        return fs::temp_directory_path() / (name + "_" + std::to_string(ML::Random::makeSeed()));
+    }
+}
+
+TEST(AutoTuneTest, MeasuresOnceThenLoadsFromCache)
+{
+    const fs::path dir = makeTempDirectory("tinyml_tune");
+    const std::vector<unsigned> topology = {16, 32, 4};
+
+    ML::AutoTuner tuner(dir.string());
+    tuner.setBudgetSeconds(0.05);
+    const ML::TuningPlan plan = tuner.tune(topology, 8);
+    ASSERT_EQ(tuner.getMeasureCount(), 1u);
+    ASSERT_GT(plan.samplesPerSecond, 0.0);
+    ASSERT_GE(plan.numThreads, 1u);
+    ASSERT_TRUE(fs::exists(tuner.getPlanPath(topology, 8)));
+
+    // A later start on this machine loads the plan instead of measuring
+    ML::AutoTuner restarted(dir.string());
+    const ML::TuningPlan loaded = restarted.tune(topology, 8);
+    ASSERT_EQ(restarted.getMeasureCount(), 0u);
+    ASSERT_EQ(loaded.blocking.kc, plan.blocking.kc);
+    ASSERT_EQ(loaded.blocking.mc, plan.blocking.mc);
+    ASSERT_EQ(loaded.blocking.nc, plan.blocking.nc);
+    ASSERT_EQ(loaded.blocking.minPackedRows, plan.blocking.minPackedRows);
+    ASSERT_EQ(loaded.numThreads, plan.numThreads);
+    ASSERT_EQ(loaded.samplesPerSecond, plan.samplesPerSecond);
+
+    // Another batch size or topology is a different plan
+    ASSERT_NE(restarted.getPlanPath(topology, 8), restarted.getPlanPath(topology, 9));
+    ASSERT_NE(restarted.getPlanPath(topology, 8), restarted.getPlanPath({16, 33, 4}, 8));
+    restarted.setBudgetSeconds(0.05);
+    restarted.tune(topology, 9);
+    ASSERT_EQ(restarted.getMeasureCount(), 1u);
+
+    fs::remove_all(dir);
+}
+
+TEST(AutoTuneTest, RejectsPlansForOtherMachines)
+{
+    const fs::path dir = makeTempDirectory("tinyml_tune_key");
+    fs::create_directories(dir);
+    const std::string path = (dir / "plan").string();
+
+    ML::TuningPlan plan;
+    plan.blocking.minPackedRows = 5;
+    plan.numThreads = 3;
+    ASSERT_TRUE(ML::AutoTuner::savePlan(plan, "cpu=a;topology=2-2", path));
+
+    ML::TuningPlan loaded;
+    ASSERT_FALSE(ML::AutoTuner::loadPlan(path, "cpu=b;topology=2-2", loaded));
+    ASSERT_TRUE(ML::AutoTuner::loadPlan(path, "cpu=a;topology=2-2", loaded));
+    ASSERT_EQ(loaded.blocking.minPackedRows, 5u);
+    ASSERT_EQ(loaded.numThreads, 3u);
+
+    std::ofstream(path) << "key cpu=a;topology=2-2\nkc 64\nmc 6\n";
+    ASSERT_FALSE(ML::AutoTuner::loadPlan(path, "cpu=a;topology=2-2", loaded));
+
+    fs::remove_all(dir);
+}
+
+TEST(AutoTuneTest, OverrideSkipsMeasuringAndCache)
+{
+    const fs::path dir = makeTempDirectory("tinyml_tune_override");
+    ML::AutoTuner tuner(dir.string());
+
+    ML::TuningPlan pinned;
+    pinned.numThreads = 2;
+    pinned.blocking.minPackedRows = 4;
+    tuner.setOverride(pinned);
+    ASSERT_TRUE(tuner.hasOverride());
+
+    const ML::TuningPlan plan = tuner.tune({8, 8, 1}, 16);
+    ASSERT_EQ(plan.numThreads, 2u);
+    ASSERT_EQ(plan.blocking.minPackedRows, 4u);
+    ASSERT_EQ(tuner.getMeasureCount(), 0u);
+    ASSERT_FALSE(fs::exists(dir));
+
+    tuner.clearOverride();
+    ASSERT_FALSE(tuner.hasOverride());
+}
+
+TEST(AutoTuneTest, AppliedPlanKeepsResultsExact)
+{
+    const std::vector<unsigned> topology = {10, 24, 3};
+    ML::Network network(topology, ML::WeightInit::Xavier, 3);
+    ML::Random rng(4);
+    std::vector<double> inputs(6 * 10);
+    for (double& x : inputs)
+        x = rng.uniform(-1.0, 1.0);
+
+    std::vector<double> expected(6 * 3), outputs(6 * 3);
+    ML::Network::feedForwardBatch(topology, network.getWeightData(), inputs.data(), 6, expected.data());
+
+    ML::TuningPlan plan;
+    plan.blocking.minPackedRows = 7;
+    ASSERT_TRUE(ML::applyTuningPlan(plan));
+    ML::Network::feedForwardBatch(topology, network.getWeightData(), inputs.data(), 6, outputs.data());
+    ML::resetGemmBlocking();
+
+    ASSERT_EQ(outputs, expected);
+    ASSERT_FALSE(ML::getCpuModel().empty());
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+#include "CodeGen.h"
+#include "CodegenTestModel.h" // generated at build time from tests/data/codegen_model.txt
+
+TEST(CodeGenTest, GeneratedHeaderMatchesModel)
+{
+    ML::Model model({3, 6, 4, 2});
+    ASSERT_TRUE(model.loadWeightsFromFile(CODEGEN_TEST_MODEL));
+
+    static_assert(codegen_test_model::numInputs == 3, "topology is baked in");
+    static_assert(codegen_test_model::numOutputs == 2, "topology is baked in");
+
+    for (double a : {0.0, 1.0, -0.25})
+        for (double b : {0.0, 1.0, 0.75})
+            for (double c : {0.0, 1.0, 0.5})
+            {
+                const double input[3] = {a, b, c};
+                double output[2];
+                codegen_test_model::predict(input, output);
+
+                model.feedForward({a, b, c});
+                const std::vector<double> expected = model.getResult();
+                ASSERT_EQ(output[0], expected[0]);
+                ASSERT_EQ(output[1], expected[1]);
+            }
+}
+
+TEST(CodeGenTest, HeaderBakesInTopologyAndWeights)
+{
+    ML::Network network({2, 3, 1}, ML::WeightInit::Xavier, 17);
+    const std::string header = ML::generateModelHeader(network, "tiny");
+
+    ASSERT_NE(header.find("namespace tiny"), std::string::npos);
+    ASSERT_NE(header.find("constexpr unsigned numInputs = 2;"), std::string::npos);
+    ASSERT_NE(header.find("alignas (64) constexpr double weights0[3][3]"), std::string::npos);
+    ASSERT_NE(header.find("alignas (64) constexpr double weights1[4][1]"), std::string::npos);
+    ASSERT_EQ(header.find("#include \""), std::string::npos); // standalone
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include "DataParallel.h"
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    std::string uniqueSocketPath(const char* name)
+    {
+        return "/tmp/tinyml-test-" + std::string(name) + "-" + std::to_string(getpid()) + ".sock";
+    }
+
+    std::vector<ML::Sample> makeDataset()
+    {
+        ML::Random rng(3, 0);
+        std::vector<ML::Sample> dataset;
+        for (int i = 0; i < 60; ++i)
+        {
+            const double a = rng.uniform(-1.0, 1.0), b = rng.uniform(-1.0, 1.0), c = rng.uniform(-1.0, 1.0);
+            dataset.push_back({{a, b, c}, {0.5 * (a * b), 0.3 * (b - c)}});
+        }
+        return dataset;
+    }
+
+    // Runs body (rank-independent) in worldSize - 1 forked children and in this process.
+    // Each child reports through the exit status, 0 meaning success.
+    template <typename Body>
+    void runInProcesses(unsigned worldSize, Body body)
+    {
+        std::vector<pid_t> children;
+        for (unsigned i = 1; i < worldSize; ++i)
+        {
+            const pid_t pid = fork();
+            ASSERT_GE(pid, 0);
+            if (pid == 0)
+                _exit(body() ? 0 : 1);
+            children.push_back(pid);
+        }
+
+        ASSERT_TRUE(body());
+        for (pid_t pid : children)
+        {
+            int status = 0;
+            ASSERT_EQ(waitpid(pid, &status, 0), pid);
+            ASSERT_TRUE(WIFEXITED(status));
+            ASSERT_EQ(WEXITSTATUS(status), 0);
+        }
+    }
+}
+
+TEST(DataParallelTest, AllReduceSumsEveryRank)
+{
+    const std::string path = uniqueSocketPath("sum");
+    const unsigned worldSize = 3;
+
+    runInProcesses(worldSize, [&]
+    {
+        auto group = ML::ProcessGroup::join(path, worldSize, 5);
+        if (!group)
+            return false;
+
+        bool ok = true;
+        for (int round = 0; round < 50; ++round)
+        {
+            std::vector<double> values(5, static_cast<double>(group->getRank() + 1 + round));
+            group->allReduceSum(values.data());
+            for (double v : values)
+                ok = ok && v == 6.0 + 3.0 * round;
+        }
+        return ok;
+    });
+}
+
+TEST(DataParallelTest, ProcessesTrainLikeOneProcess)
+{
+    const std::vector<unsigned> topology = {3, 6, 2};
+    const std::vector<ML::Sample> dataset = makeDataset();
+
+    ML::Network reference(topology, ML::WeightInit::Xavier, 11);
+    auto single = ML::ProcessGroup::join(uniqueSocketPath("single"), 1, ML::dataParallelCount(reference));
+    ASSERT_TRUE(single);
+    const double referenceLoss = ML::trainDataParallel(reference, *single, dataset, 12, 20);
+    const std::vector<double> referenceWeights = reference.getWeights();
+
+    // Every rank checks its replica against the single-process run and the shared loss
+    const std::string path = uniqueSocketPath("train");
+    runInProcesses(3, [&]
+    {
+        ML::Network network(topology, ML::WeightInit::Xavier, 11);
+        auto group = ML::ProcessGroup::join(path, 3, ML::dataParallelCount(network));
+        if (!group)
+            return false;
+
+        const double loss = ML::trainDataParallel(network, *group, dataset, 12, 20);
+        const std::vector<double> weights = network.getWeights();
+        bool ok = std::abs(loss - referenceLoss) < 1e-9;
+        for (std::size_t i = 0; i < weights.size(); ++i)
+            ok = ok && std::abs(weights[i] - referenceWeights[i]) < 1e-9;
+        return ok;
+    });
+}
+
+TEST(DataParallelTest, ApplyGradientMatchesBackPropagate)
+{
+    ML::Network stepped({2, 4, 1}, ML::WeightInit::Xavier, 5);
+    ML::Network accumulated({2, 4, 1}, ML::WeightInit::Xavier, 5);
+    const std::vector<double> input = {0.4, -0.7};
+    const std::vector<double> target = {0.25};
+
+    std::vector<double> gradient(accumulated.getNumWeights());
+    for (int step = 0; step < 5; ++step)
+    {
+        stepped.trainStep(input, target);
+        std::fill(gradient.begin(), gradient.end(), 0.0);
+        accumulated.accumulateGradient(input.data(), target.data(), gradient.data());
+        accumulated.applyGradient(gradient.data());
+    }
+
+    const std::vector<double> a = stepped.getWeights(), b = accumulated.getWeights();
+    for (std::size_t i = 0; i < a.size(); ++i)
+        ASSERT_NEAR(a[i], b[i], 1e-12);
+}
+
+TEST(DataParallelTest, MismatchedCountIsRejected)
+{
+    ML::Network network({2, 3, 1});
+    auto group = ML::ProcessGroup::join(uniqueSocketPath("count"), 1, 3);
+    ASSERT_TRUE(group);
+    ASSERT_TRUE(std::isnan(ML::trainDataParallel(network, *group, {{{0.0, 1.0}, {1.0}}}, 4, 1)));
+}
+
+TEST(DataParallelTest, StaleSocketFileIsReplaced)
+{
+    // A bound socket closed without unlinking is what a crashed host leaves behind
+    const std::string path = uniqueSocketPath("stale");
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+    const int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_EQ(bind(stale, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+    close(stale);
+
+    runInProcesses(2, [&]
+    {
+        auto group = ML::ProcessGroup::join(path, 2, 1, 5.0);
+        if (!group)
+            return false;
+        double value = 1.0;
+        group->allReduceSum(&value);
+        return value == 2.0;
+    });
+}
+
+TEST(DataParallelTest, MismatchedJoinerTakesNoRank)
+{
+    const std::string path = uniqueSocketPath("mismatch");
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        usleep(100000);
+        _exit(ML::ProcessGroup::join(path, 2, 7, 2.0) == nullptr ? 0 : 1);
+    }
+
+    // The host only times out; it does not hand the mismatched process a rank
+    ASSERT_FALSE(ML::ProcessGroup::join(path, 2, 5, 1.0));
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST(DataParallelTest, RankThatNeverMapsFailsTheGroup)
+{
+    // A process takes rank 2 of 3 and exits without mapping the segment; the other two
+    // must give up at the deadline instead of waiting in the startup barrier
+    const std::string path = uniqueSocketPath("vanish");
+    const pid_t vanisher = fork();
+    ASSERT_GE(vanisher, 0);
+    if (vanisher == 0)
+    {
+        usleep(100000);
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+        int connection = -1;
+        for (int attempt = 0; attempt < 100 && connection < 0; ++attempt)
+        {
+            connection = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+            {
+                close(connection);
+                connection = -1;
+                usleep(10000);
+            }
+        }
+        struct { std::uint32_t worldSize; std::uint64_t count; } request { 3, 4 };
+        char welcome[128];
+        const bool ok = connection >= 0
+                        && write(connection, &request, sizeof(request)) == static_cast<ssize_t>(sizeof(request))
+                        && read(connection, welcome, sizeof(welcome)) > 0;
+        _exit(ok ? 0 : 1);
+    }
+
+    const pid_t member = fork();
+    ASSERT_GE(member, 0);
+    if (member == 0)
+    {
+        usleep(200000);
+        _exit(ML::ProcessGroup::join(path, 3, 4, 2.0) == nullptr ? 0 : 1);
+    }
+
+    ASSERT_FALSE(ML::ProcessGroup::join(path, 3, 4, 2.0));
+    for (pid_t pid : {vanisher, member})
+    {
+        int status = 0;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status));
+        ASSERT_EQ(WEXITSTATUS(status), 0);
+    }
+}
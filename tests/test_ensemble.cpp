@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "Ensemble.h"
+#include <memory>
+
+TEST(EnsembleTest, ModelsStartAsSeededNetworks)
+{
+    ML::Ensemble ensemble({2, 8, 1}, 5, ML::WeightInit::Xavier, 100);
+    ASSERT_EQ(ensemble.size(), 5u);
+
+    for (std::size_t model = 0; model < ensemble.size(); ++model)
+    {
+        ML::Network network({2, 8, 1}, ML::WeightInit::Xavier, 100 + model);
+        ASSERT_EQ(ensemble.getWeights(model), network.getWeights());
+    }
+}
+
+TEST(EnsembleTest, TrainsEachModelLikeItsNetwork)
+{
+    const std::vector<unsigned> topology = {3, 6, 4, 2};
+    const std::size_t numModels = 11; // not a multiple of the lane padding
+
+    ML::Ensemble ensemble(topology, numModels, ML::WeightInit::Xavier, 7);
+    std::vector<std::unique_ptr<ML::Network>> networks;
+    for (std::size_t model = 0; model < numModels; ++model)
+    {
+        networks.push_back(std::make_unique<ML::Network>(topology, ML::WeightInit::Xavier, 7 + model));
+    }
+
+    std::vector<double> expected, actual;
+    for (int step = 0; step < 50; ++step)
+    {
+        const std::vector<double> input = {0.1 * (step % 5), -0.3, 0.05 * step};
+        const std::vector<double> target = {0.5, -0.25};
+
+        ensemble.feedForward(input);
+        for (std::size_t model = 0; model < numModels; ++model)
+        {
+            networks[model]->feedForward(input);
+            networks[model]->getResults(expected);
+            ensemble.getResults(model, actual);
+            ASSERT_EQ(actual, expected);
+        }
+
+        ensemble.backPropagate(target);
+        for (std::size_t model = 0; model < numModels; ++model)
+        {
+            networks[model]->backPropagate(target);
+            ASSERT_EQ(ensemble.getRecentAverageError(model), networks[model]->getRecentAverageError());
+        }
+    }
+
+    for (std::size_t model = 0; model < numModels; ++model)
+    {
+        ASSERT_EQ(ensemble.getWeights(model), networks[model]->getWeights());
+    }
+}
+
+TEST(EnsembleTest, MeanAndVarianceAcrossModels)
+{
+    ML::Ensemble ensemble({2, 4, 2}, 3, ML::WeightInit::Xavier, 1);
+    ensemble.feedForward({0.7, -0.2});
+
+    std::vector<double> mean, variance, result;
+    ensemble.getMeanAndVariance(mean, variance);
+    ASSERT_EQ(mean.size(), 2u);
+
+    for (std::size_t n = 0; n < 2; ++n)
+    {
+        double sum = 0.0, squares = 0.0;
+        for (std::size_t model = 0; model < 3; ++model)
+        {
+            ensemble.getResults(model, result);
+            sum += result[n];
+            squares += result[n] * result[n];
+        }
+        ASSERT_NEAR(mean[n], sum / 3, 1e-15);
+        ASSERT_NEAR(variance[n], squares / 3 - (sum / 3) * (sum / 3), 1e-12);
+        ASSERT_GT(variance[n], 0.0);
+    }
+}
+
+TEST(EnsembleTest, PutWeightsTouchesOnlyOneModel)
+{
+    ML::Ensemble ensemble({2, 3, 1}, 4, ML::WeightInit::He, 9);
+    const std::vector<double> other = ensemble.getWeights(2);
+
+    std::vector<double> weights(ensemble.getNumWeights(), 0.25);
+    ensemble.putWeights(1, weights);
+
+    ASSERT_EQ(ensemble.getWeights(1), weights);
+    ASSERT_EQ(ensemble.getWeights(2), other);
+}
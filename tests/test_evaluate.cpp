@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "Model.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    std::vector<ML::Sample> makeDataset(std::size_t count, std::size_t numInputs, std::size_t numClasses)
+    {
+        ML::Random rng(17, 0);
+        std::vector<ML::Sample> dataset;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::vector<double> input(numInputs), target(numClasses, 0.0);
+            for (double& x : input)
+                x = rng.uniform(-1.0, 1.0);
+            target[i % numClasses] = 1.0;
+            dataset.push_back({input, target});
+        }
+        return dataset;
+    }
+}
+
+TEST(EvaluateTest, MatchesSampleBySampleLoop)
+{
+    ML::Model model({4, 6, 3}, ML::WeightInit::Xavier, 23);
+    model.setLoss(ML::Loss::CategoricalCrossEntropy);
+    const std::vector<ML::Sample> dataset = makeDataset(1000, 4, 3);
+
+    std::size_t correct = 0;
+    double squared = 0.0, absolute = 0.0, logLoss = 0.0;
+    std::vector<std::size_t> confusion(9, 0);
+    for (const auto& [input, target] : dataset)
+    {
+        model.feedForward(input);
+        const std::vector<double> p = model.getPredictions();
+        const std::size_t predicted = std::max_element(p.begin(), p.end()) - p.begin();
+        const std::size_t actual = std::max_element(target.begin(), target.end()) - target.begin();
+        correct += predicted == actual;
+        ++confusion[actual * 3 + predicted];
+        logLoss -= std::log(p[actual]);
+        for (std::size_t n = 0; n < 3; ++n)
+        {
+            squared += (p[n] - target[n]) * (p[n] - target[n]);
+            absolute += std::abs(p[n] - target[n]);
+        }
+    }
+
+    const ML::EvaluationResult result = model.evaluate(dataset, ML::Metric::All, 3);
+    ASSERT_EQ(result.numSamples, dataset.size());
+    ASSERT_EQ(result.numClasses, 3u);
+    ASSERT_DOUBLE_EQ(result.accuracy, static_cast<double>(correct) / dataset.size());
+    ASSERT_NEAR(result.rmse, std::sqrt(squared / (3.0 * dataset.size())), 1e-12);
+    ASSERT_NEAR(result.mae, absolute / (3.0 * dataset.size()), 1e-12);
+    ASSERT_NEAR(result.logLoss, logLoss / dataset.size(), 1e-12);
+    ASSERT_EQ(result.confusionMatrix, confusion);
+    ASSERT_EQ(result.getConfusion(1, 2), confusion[5]);
+}
+
+TEST(EvaluateTest, SameResultForAnyThreadCount)
+{
+    ML::Network network({5, 8, 2}, ML::WeightInit::Xavier, 29);
+    const std::vector<ML::Sample> dataset = makeDataset(3001, 5, 2);
+
+    const ML::EvaluationResult single = ML::evaluate(network, dataset, ML::Metric::All, 1);
+    for (unsigned threads : {2u, 4u, 7u})
+    {
+        const ML::EvaluationResult parallel = ML::evaluate(network, dataset, ML::Metric::All, threads);
+        ASSERT_EQ(parallel.accuracy, single.accuracy);
+        ASSERT_EQ(parallel.rmse, single.rmse);
+        ASSERT_EQ(parallel.mae, single.mae);
+        ASSERT_EQ(parallel.logLoss, single.logLoss);
+        ASSERT_EQ(parallel.confusionMatrix, single.confusionMatrix);
+    }
+}
+
+TEST(EvaluateTest, SingleOutputUsesHalfAsThreshold)
+{
+    // A lone bias-free output of tanh (0) = 0 predicts class 0 for every sample
+    ML::Network network({1, 1});
+    network.putWeights({0.0, 0.0});
+    const std::vector<ML::Sample> dataset = {{{0.3}, {0.0}}, {{-0.2}, {1.0}}, {{0.9}, {0.0}}};
+
+    const ML::EvaluationResult result = ML::evaluate(network, dataset, ML::Metric::Accuracy | ML::Metric::ConfusionMatrix);
+    ASSERT_EQ(result.numClasses, 2u);
+    ASSERT_NEAR(result.accuracy, 2.0 / 3.0, 1e-12);
+    ASSERT_EQ(result.getConfusion(0, 0), 2u);
+    ASSERT_EQ(result.getConfusion(1, 0), 1u);
+    ASSERT_EQ(result.rmse, 0.0); // not requested
+}
+
+TEST(EvaluateTest, MismatchedSampleIsRejected)
+{
+    ML::Network network({2, 3, 1});
+    const ML::EvaluationResult result = ML::evaluate(network, {{{1.0, 2.0, 3.0}, {1.0}}});
+    ASSERT_EQ(result.numSamples, 0u);
+    ASSERT_TRUE(result.confusionMatrix.empty());
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "Gemm.h"
+#include "Random.h"
+#include <vector>
+
+namespace
+{
+    std::vector<double> randomMatrix(std::size_t count, std::uint64_t seed)
+    {
+        ML::Random rng(seed);
+        std::vector<double> values(count);
+        for (double& v : values)
+        {
+            v = rng.uniform(-1.0, 1.0);
+        }
+        return values;
+    }
+}
+
+TEST(GemmTest, BlockingFitsTheCaches)
+{
+    const ML::CacheSizes& caches = ML::getCacheSizes();
+    const ML::GemmBlocking& blocking = ML::getGemmBlocking();
+
+    ASSERT_GT(caches.l1, 0u);
+    ASSERT_LE(caches.l1, caches.l2);
+    ASSERT_EQ(blocking.mc % ML::GemmBlocking::mr, 0u);
+    ASSERT_EQ(blocking.nc % ML::GemmBlocking::nr, 0u);
+    ASSERT_LE(blocking.kc * (ML::GemmBlocking::mr + ML::GemmBlocking::nr) * sizeof(double), std::max<std::size_t>(caches.l1, 4096));
+}
+
+TEST(GemmTest, GemmMatchesTripleLoopExactly)
+{
+    // Deliberately ragged sizes, with k spanning several kc blocks
+    const std::size_t m = 37, n = 45, k = 3 * ML::getGemmBlocking().kc + 5;
+    const std::size_t lda = k + 3, ldb = n + 1, ldc = n + 2;
+    const std::vector<double> a = randomMatrix(m * lda, 1);
+    const std::vector<double> b = randomMatrix(k * ldb, 2);
+    const std::vector<double> initial = randomMatrix(m * ldc, 3);
+
+    for (double beta : {0.0, 1.0})
+    {
+        std::vector<double> c = initial, expected = initial;
+        ML::gemm(m, n, k, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                double sum = beta == 0.0 ? 0.0 : expected[i * ldc + j];
+                for (std::size_t p = 0; p < k; ++p)
+                {
+                    sum += a[i * lda + p] * b[p * ldb + j];
+                }
+                expected[i * ldc + j] = sum;
+            }
+        }
+
+        ASSERT_EQ(c, expected); // padding between rows untouched too
+    }
+}
+
+TEST(GemmTest, GemvAndTransposeMatchLoopsExactly)
+{
+    const std::size_t m = 1027, n = 515;
+    const std::vector<double> a = randomMatrix(m * n, 4);
+    const std::vector<double> xm = randomMatrix(m, 5);
+    const std::vector<double> xn = randomMatrix(n, 6);
+
+    std::vector<double> y(m), expectedY(m, 0.0);
+    ML::gemv(m, n, a.data(), n, xn.data(), 0.0, y.data());
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            expectedY[i] += a[i * n + j] * xn[j];
+        }
+    }
+    ASSERT_EQ(y, expectedY);
+
+    std::vector<double> yt(n, 0.5), expectedYt(n, 0.5);
+    ML::gemvT(m, n, a.data(), n, xm.data(), 1.0, yt.data());
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            expectedYt[j] += xm[i] * a[i * n + j];
+        }
+    }
+    ASSERT_EQ(yt, expectedYt);
+}
+
+TEST(GemmTest, AnyBlockingGivesTheSameResult)
+{
+    const std::size_t m = 13, n = 29, k = 150;
+    const std::vector<double> a = randomMatrix(m * k, 7);
+    const std::vector<double> b = randomMatrix(k * n, 8);
+
+    std::vector<double> expected(m * n);
+    ML::gemm(m, n, k, a.data(), k, b.data(), n, 0.0, expected.data(), n);
+
+    ML::GemmBlocking small = ML::getDefaultGemmBlocking();
+    small.kc = 16;
+    small.mc = 8;
+    small.nc = 8;
+    ML::GemmBlocking rowByRow = ML::getDefaultGemmBlocking();
+    rowByRow.minPackedRows = m + 1;
+
+    for (const ML::GemmBlocking& blocking : {small, rowByRow})
+    {
+        ASSERT_TRUE(ML::setGemmBlocking(blocking));
+        ASSERT_EQ(ML::getGemmBlocking().kc, blocking.kc);
+
+        for (double beta : {0.0, 1.0})
+        {
+            std::vector<double> c = expected, reference = expected;
+            ML::resetGemmBlocking();
+            ML::gemm(m, n, k, a.data(), k, b.data(), n, beta, reference.data(), n);
+            ML::setGemmBlocking(blocking);
+            ML::gemm(m, n, k, a.data(), k, b.data(), n, beta, c.data(), n);
+            ASSERT_EQ(c, reference);
+        }
+    }
+
+    ML::GemmBlocking invalid = small;
+    invalid.mc = 6;
+    ASSERT_FALSE(ML::setGemmBlocking(invalid));
+    ASSERT_EQ(ML::getGemmBlocking().mc, rowByRow.mc);
+
+    ML::resetGemmBlocking();
+    ASSERT_EQ(ML::getGemmBlocking().kc, ML::getDefaultGemmBlocking().kc);
+    ASSERT_EQ(ML::getGemmBlocking().minPackedRows, 0u);
+}
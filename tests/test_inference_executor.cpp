@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "InferenceExecutor.h"
+#include <thread>
+
+TEST(InferenceExecutorTest, BatchedForwardMatchesSingleSamples)
+{
+    ML::Network network({3, 7, 5, 2}, ML::WeightInit::Xavier, 21);
+    const std::vector<double> inputs = {0.1, 0.2, 0.3, -0.4, 0.5, -0.6, 0.7, 0.8, -0.9};
+
+    std::vector<double> batched(3 * 2);
+    ML::Network::feedForwardBatch(network.getTopology(), network.getWeightData(), inputs.data(), 3, batched.data());
+
+    for (std::size_t b = 0; b < 3; ++b)
+    {
+        std::vector<double> single(2);
+        ML::Network::feedForward(network.getTopology(), network.getWeightData(), inputs.data() + b * 3, single.data());
+        ASSERT_EQ(single[0], batched[b * 2]);
+        ASSERT_EQ(single[1], batched[b * 2 + 1]);
+    }
+}
+
+TEST(InferenceExecutorTest, FullQueueFormsOneBatch)
+{
+    ML::Network network({2, 4, 1}, ML::WeightInit::Xavier, 8);
+    ML::InferenceExecutor executor(network, 8, std::chrono::seconds(10));
+
+    std::vector<std::future<std::vector<double>>> results;
+    for (int i = 0; i < 8; ++i)
+        results.push_back(executor.submit({0.1 * i, -0.1 * i}));
+
+    for (int i = 0; i < 8; ++i)
+    {
+        network.feedForward({0.1 * i, -0.1 * i});
+        std::vector<double> expected;
+        network.getResults(expected);
+        ASSERT_EQ(results[i].get(), expected);
+    }
+
+    ML::InferenceStats stats = executor.getStats();
+    ASSERT_EQ(stats.numRequests, 8u);
+    ASSERT_EQ(stats.numBatches, 1u);
+    ASSERT_EQ(stats.batchSizes[8], 1u);
+    ASSERT_DOUBLE_EQ(stats.meanBatchSize, 8.0);
+    ASSERT_LE(stats.p50Micros, stats.p99Micros);
+}
+
+TEST(InferenceExecutorTest, ServesManyConcurrentCallers)
+{
+    ML::Network network({4, 16, 3}, ML::WeightInit::Xavier, 9);
+    ML::InferenceExecutor executor(network, 16, std::chrono::microseconds(500), 2);
+
+    std::atomic<int> mismatches { 0 };
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 32; ++t)
+    {
+        callers.emplace_back([&, t]
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                std::vector<double> input = {0.01 * t, 0.02 * i, -0.5, 1.0};
+                std::vector<double> expected(3);
+                ML::Network::feedForward(network.getTopology(), network.getWeightData(), input.data(), expected.data());
+                if (executor.submit(input).get() != expected)
+                    ++mismatches;
+            }
+        });
+    }
+    for (auto& caller : callers)
+        caller.join();
+
+    ASSERT_EQ(mismatches.load(), 0);
+
+    ML::InferenceStats stats = executor.getStats();
+    ASSERT_EQ(stats.numRequests, 32u * 50u);
+    ASSERT_EQ(stats.latency.getCount(), stats.numRequests);
+
+    std::uint64_t batchedRequests = 0;
+    for (std::size_t size = 0; size < stats.batchSizes.size(); ++size)
+        batchedRequests += size * stats.batchSizes[size];
+    ASSERT_EQ(batchedRequests, stats.numRequests);
+}
+
+TEST(InferenceExecutorTest, MalformedInputFailsOnlyItsOwnRequest)
+{
+    ML::Network network({2, 2, 1}, ML::WeightInit::Xavier, 4);
+    ML::InferenceExecutor executor(network, 4, std::chrono::seconds(10));
+
+    auto bad = executor.submit({1.0, 2.0, 3.0});
+    auto good1 = executor.submit({1.0, 2.0});
+    auto good2 = executor.submit({0.0, 1.0});
+    auto good3 = executor.submit({1.0, 0.0});
+
+    ASSERT_THROW(bad.get(), std::invalid_argument);
+    ASSERT_EQ(good1.get().size(), 1u);
+    ASSERT_EQ(good2.get().size(), 1u);
+    ASSERT_EQ(good3.get().size(), 1u);
+
+    // The rejected request was never run, so the stats see a batch of three
+    ML::InferenceStats stats = executor.getStats();
+    ASSERT_EQ(stats.numRequests, 3u);
+    ASSERT_EQ(stats.numBatches, 1u);
+    ASSERT_EQ(stats.batchSizes[3], 1u);
+    ASSERT_EQ(stats.batchSizes[4], 0u);
+
+    // A batch with nothing valid in it is not counted at all
+    std::vector<std::future<std::vector<double>>> rejected;
+    for (int i = 0; i < 4; ++i)
+        rejected.push_back(executor.submit({1.0}));
+    for (auto& result : rejected)
+        ASSERT_THROW(result.get(), std::invalid_argument);
+    stats = executor.getStats();
+    ASSERT_EQ(stats.numRequests, 3u);
+    ASSERT_EQ(stats.numBatches, 1u);
+    ASSERT_EQ(stats.batchSizes[0], 0u);
+}
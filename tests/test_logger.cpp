@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "logger.h"
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::vector<std::string> splitLines(const std::string& text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line))
+            lines.push_back(line);
+        return lines;
+    }
+
+    int countingArgument(int& evaluations)
+    {
+        ++evaluations;
+        return evaluations;
+    }
+}
+
+TEST(LoggerTest, SyncFormatIsUnchanged)
+{
+    std::ostringstream out;
+    LoggerNS::Logger logger(LoggerNS::Logger::VerbosityLevel::INFO, LoggerNS::Logger::Mode::Sync, out);
+    logger.logInfo("hello");
+    logger.logResult("Case", {1.0}, {0.5, 0.25});
+    logger.logDebug("hidden");
+
+    std::vector<std::string> lines = splitLines(out.str());
+    ASSERT_EQ(lines.size(), 2u);
+    ASSERT_EQ(lines[0].front(), '[');
+    ASSERT_NE(lines[0].find("] INFO: hello"), std::string::npos);
+    ASSERT_NE(lines[1].find("INFO: Case - Expected: [1.0000], Actual: [0.5000, 0.2500]"), std::string::npos);
+}
+
+TEST(LoggerTest, AsyncMatchesSyncOutput)
+{
+    std::ostringstream syncOut, asyncOut;
+    LoggerNS::Logger syncLogger(LoggerNS::Logger::VerbosityLevel::DEBUG, LoggerNS::Logger::Mode::Sync, syncOut);
+    LoggerNS::Logger asyncLogger(LoggerNS::Logger::VerbosityLevel::DEBUG, LoggerNS::Logger::Mode::Async, asyncOut);
+
+    for (LoggerNS::Logger* logger : {&syncLogger, &asyncLogger})
+    {
+        logger->logError("bad");
+        logger->logDebug("detail");
+        logger->logResult("Case", {0.0, 1.0}, {0.125});
+        logger->flush();
+    }
+
+    std::vector<std::string> syncLines = splitLines(syncOut.str());
+    std::vector<std::string> asyncLines = splitLines(asyncOut.str());
+    ASSERT_EQ(asyncLines.size(), 3u);
+    ASSERT_EQ(syncLines.size(), asyncLines.size());
+
+    // Compare everything after the timestamp
+    for (size_t i = 0; i < syncLines.size(); ++i)
+        ASSERT_EQ(syncLines[i].substr(syncLines[i].find(']')), asyncLines[i].substr(asyncLines[i].find(']')));
+}
+
+TEST(LoggerTest, AsyncKeepsEveryRecordInPerThreadOrder)
+{
+    std::ostringstream out;
+    const int numThreads = 4;
+    // More than one ring's worth per thread, so producers have to wait on the writer
+    const int perThread = static_cast<int>(LoggerNS::AsyncLogBackend::ringCapacity) * 3;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&out, t, perThread]
+        {
+            LoggerNS::Logger logger(LoggerNS::Logger::VerbosityLevel::INFO, LoggerNS::Logger::Mode::Async, out);
+            for (int i = 0; i < perThread; ++i)
+                logger.logInfo("t" + std::to_string(t) + " " + std::to_string(i));
+            logger.flush();
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::vector<int> next(numThreads, 0);
+    std::vector<std::string> lines = splitLines(out.str());
+    ASSERT_EQ(lines.size(), static_cast<size_t>(numThreads * perThread));
+    for (const std::string& line : lines)
+    {
+        std::istringstream fields(line.substr(line.find("INFO: t") + 7));
+        int t, i;
+        fields >> t >> i;
+        ASSERT_EQ(i, next[t]);
+        ++next[t];
+    }
+}
+
+TEST(LoggerTest, AsyncLoggerDrainsBeforeDestruction)
+{
+    // The stream dies right after the logger, with no explicit flush in between
+    auto out = std::make_unique<std::ostringstream>();
+    {
+        LoggerNS::Logger logger(LoggerNS::Logger::VerbosityLevel::INFO, LoggerNS::Logger::Mode::Async, *out);
+        for (int i = 0; i < 100; ++i)
+            logger.logInfo("line " + std::to_string(i));
+        logger.logResult("result", {1.0}, {0.5});
+    }
+    const std::vector<std::string> lines = splitLines(out->str());
+    out.reset();
+    ASSERT_EQ(lines.size(), 101u);
+}
+
+TEST(LoggerTest, DisabledMacrosSkipArguments)
+{
+    std::ostringstream out;
+    LoggerNS::Logger logger(LoggerNS::Logger::VerbosityLevel::ERROR, LoggerNS::Logger::Mode::Sync, out);
+    int evaluations = 0;
+
+    LOGGER_DEBUG(logger, std::to_string(countingArgument(evaluations)));
+    LOGGER_INFO(logger, std::to_string(countingArgument(evaluations)));
+    ASSERT_EQ(evaluations, 0);
+    ASSERT_TRUE(out.str().empty());
+
+    LOGGER_ERROR(logger, std::to_string(countingArgument(evaluations)));
+    ASSERT_EQ(evaluations, 1);
+    ASSERT_NE(out.str().find("ERROR: 1"), std::string::npos);
+}
+
+TEST(LoggerTest, CompiledOutLevels)
+{
+    ASSERT_EQ(LoggerNS::Logger::isCompiledIn(LoggerNS::Logger::VerbosityLevel::DEBUG), LOGGER_MAX_VERBOSITY >= 3);
+    ASSERT_TRUE(LoggerNS::Logger::isCompiledIn(LoggerNS::Logger::VerbosityLevel::NONE));
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "LookupGrid.h"
+#include "Perceptron.h"
+#include <cmath>
+
+namespace
+{
+    std::vector<double> exactOutputs(const ML::Network& network, const std::vector<double>& input)
+    {
+        std::vector<double> outputs(network.getTopology().back());
+        ML::Network::feedForwardBatch(network.getTopology(), network.getWeightData(), input.data(), 1, outputs.data());
+        return outputs;
+    }
+}
+
+TEST(LookupGridTest, ExactAtNodes)
+{
+    ML::Network network({2, 8, 3}, ML::WeightInit::Xavier, 5);
+    ML::LookupGrid grid(network, {{-1.0, 1.0, 9}, {0.0, 2.0, 5}});
+    ASSERT_TRUE(grid.isValid());
+    ASSERT_EQ(grid.getNumNodes(), 45u);
+
+    for (ML::GridInterpolation interpolation : {ML::GridInterpolation::Linear, ML::GridInterpolation::Cubic})
+    {
+        ML::LookupGrid g(network, {{-1.0, 1.0, 9}, {0.0, 2.0, 5}}, interpolation);
+        std::vector<double> outputs;
+        for (int i = 0; i < 9; ++i)
+        {
+            for (int j = 0; j < 5; ++j)
+            {
+                const std::vector<double> input = {-1.0 + 0.25 * i, 0.5 * j};
+                g.query(input, outputs);
+                const std::vector<double> exact = exactOutputs(network, input);
+                for (std::size_t n = 0; n < exact.size(); ++n)
+                    ASSERT_NEAR(outputs[n], exact[n], 1e-12);
+            }
+        }
+    }
+}
+
+TEST(LookupGridTest, ErrorShrinksWithResolution)
+{
+    ML::Network network({3, 6, 2}, ML::WeightInit::Xavier, 11);
+    double previousLinear = 1e9, previousCubic = 1e9;
+
+    for (unsigned points : {5u, 9u, 17u})
+    {
+        const std::vector<ML::GridAxis> axes(3, {-1.0, 1.0, points});
+        ML::LookupGrid linear(network, axes, ML::GridInterpolation::Linear);
+        ML::LookupGrid cubic(network, axes, ML::GridInterpolation::Cubic);
+
+        const ML::GridErrorReport linearReport = linear.measureError(2000, 3);
+        const ML::GridErrorReport cubicReport = cubic.measureError(2000, 3);
+        ASSERT_EQ(linearReport.samplesChecked, 2000u);
+        ASSERT_LT(linearReport.maxError, previousLinear);
+        ASSERT_LT(cubicReport.maxError, previousCubic);
+        ASSERT_LE(linearReport.meanError, linearReport.maxError);
+        previousLinear = linearReport.maxError;
+        previousCubic = cubicReport.maxError;
+    }
+
+    ASSERT_LT(previousLinear, 0.05);
+    ASSERT_LT(previousCubic, previousLinear);
+}
+
+TEST(LookupGridTest, MaxErrorBoundsQueriedPoints)
+{
+    ML::Network network({1, 10, 1}, ML::WeightInit::Xavier, 29);
+    ML::LookupGrid grid(network, {{-2.0, 2.0, 12}});
+    const ML::GridErrorReport report = grid.measureError(5000, 7);
+    ASSERT_EQ(report.worstInput.size(), 1u);
+
+    std::vector<double> outputs;
+    grid.query(report.worstInput, outputs);
+    ASSERT_NEAR(std::abs(outputs[0] - exactOutputs(network, report.worstInput)[0]), report.maxError, 1e-12);
+
+    // Inputs past either end are clamped to the axis
+    std::vector<double> clamped;
+    grid.query({5.0}, outputs);
+    grid.query({2.0}, clamped);
+    ASSERT_DOUBLE_EQ(outputs[0], clamped[0]);
+}
+
+TEST(LookupGridTest, RebakesAfterTraining)
+{
+    ML::Network network({2, 4, 1}, ML::WeightInit::Xavier, 13);
+    ML::LookupGrid grid(network, {{0.0, 1.0, 17}, {0.0, 1.0, 17}});
+    std::vector<double> before, after;
+
+    grid.query({0.5, 0.5}, before);
+    grid.query({0.25, 0.75}, before);
+    ASSERT_EQ(grid.getBakeCount(), 1u);
+
+    for (int i = 0; i < 20; ++i)
+        network.trainStep({0.25, 0.75}, {0.9});
+
+    grid.query({0.25, 0.75}, after);
+    ASSERT_EQ(grid.getBakeCount(), 2u);
+    ASSERT_NE(before[0], after[0]);
+    ASSERT_NEAR(after[0], exactOutputs(network, {0.25, 0.75})[0], 1e-12);
+
+    network.putWeights(network.getWeights());
+    grid.query({0.25, 0.75}, after);
+    ASSERT_EQ(grid.getBakeCount(), 3u);
+}
+
+TEST(LookupGridTest, RejectsTooManyInputs)
+{
+    ML::Network network({4, 3, 1}, ML::WeightInit::Xavier, 1);
+    ML::LookupGrid grid(network, std::vector<ML::GridAxis>(4));
+    ASSERT_FALSE(grid.isValid());
+
+    ML::Network small({2, 3, 1}, ML::WeightInit::Xavier, 1);
+    ASSERT_FALSE(ML::LookupGrid(small, {{0.0, 1.0, 9}}).isValid());
+    ASSERT_FALSE(ML::LookupGrid(small, {{0.0, 1.0, 1}, {0.0, 1.0, 9}}).isValid());
+}
+
+TEST(LookupGridTest, LinReg2DUsesGrid)
+{
+    ML::Models::LinReg2D model(3, 8);
+    model.setValuesToLearn({0.2, -0.4, 0.6});
+    model.setXAndYValues(0.3, 0.7);
+    for (int i = 0; i < 50; ++i)
+        model.Learn();
+
+    model.calculateResult();
+    const std::vector<double> direct = model.results;
+
+    model.enableLookupGrid(129, ML::GridInterpolation::Cubic);
+    ASSERT_NE(model.getLookupGrid(), nullptr);
+    model.calculateResult();
+    ASSERT_EQ(model.results.size(), direct.size());
+    const double maxError = model.getLookupGrid()->measureError(2000).maxError;
+    for (std::size_t n = 0; n < direct.size(); ++n)
+        ASSERT_NEAR(model.results[n], direct[n], 1e-4 + maxError);
+
+    model.Learn();
+    model.calculateResult();
+    ASSERT_EQ(model.getLookupGrid()->getBakeCount(), 2u);
+
+    model.disableLookupGrid();
+    ASSERT_EQ(model.getLookupGrid(), nullptr);
+}
+
+TEST(LookupGridTest, MovedLinReg2DKeepsItsGrid)
+{
+    ML::Models::LinReg2D original(2, 6);
+    original.setXAndYValues(0.4, 0.6);
+    original.enableLookupGrid(33);
+
+    // The moved-to model's grid must read its own network, not the one left behind
+    ML::Models::LinReg2D moved(std::move(original));
+    ASSERT_NE(moved.getLookupGrid(), nullptr);
+    ASSERT_EQ(original.getLookupGrid(), nullptr);
+    ASSERT_EQ(moved.getLookupGrid()->getAxes()[0].points, 33u);
+    moved.calculateResult();
+    const std::vector<double> fromGrid = moved.results;
+    moved.disableLookupGrid();
+    moved.calculateResult();
+    for (std::size_t n = 0; n < fromGrid.size(); ++n)
+        ASSERT_NEAR(fromGrid[n], moved.results[n], 1e-2);
+
+    ML::Models::LinReg2D assigned(2, 6);
+    moved.enableLookupGrid(17, ML::GridInterpolation::Cubic);
+    assigned = std::move(moved);
+    ASSERT_NE(assigned.getLookupGrid(), nullptr);
+    ASSERT_EQ(assigned.getLookupGrid()->getInterpolation(), ML::GridInterpolation::Cubic);
+    ASSERT_EQ(moved.getLookupGrid(), nullptr);
+    assigned.calculateResult();
+    ASSERT_EQ(assigned.results.size(), 2u);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "Loss.h"
+#include "Network.h"
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+    // -dL/dz by central differences, scaled the way computeLoss reports each loss
+    std::vector<double> numericGradients(ML::Loss loss, std::vector<double> sums, const std::vector<double>& targets)
+    {
+        const std::size_t n = sums.size();
+        const double scale = loss == ML::Loss::CategoricalCrossEntropy ? 1.0 : static_cast<double>(n);
+        const double h = 1e-6;
+        std::vector<double> gradients(n), scratch(n), outputs(n);
+
+        auto evaluate = [&]
+        {
+            for (std::size_t k = 0; k < n; ++k)
+                outputs[k] = std::tanh(sums[k]);
+            return ML::computeLoss(loss, n, outputs.data(), sums.data(), targets.data(), scratch.data(), 0.25);
+        };
+
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const double z = sums[k];
+            sums[k] = z + h;
+            const double up = evaluate();
+            sums[k] = z - h;
+            const double down = evaluate();
+            sums[k] = z;
+            gradients[k] = -scale * (up - down) / (2.0 * h);
+        }
+        return gradients;
+    }
+}
+
+TEST(LossTest, GradientsMatchFiniteDifferences)
+{
+    const std::vector<double> sums = {0.3, -1.2, 0.05, 2.0};
+    const std::vector<double> targets = {0.0, 1.0, 0.0, 0.0};
+    std::vector<double> outputs(sums.size()), gradients(sums.size());
+    for (std::size_t k = 0; k < sums.size(); ++k)
+        outputs[k] = std::tanh(sums[k]);
+
+    for (ML::Loss loss : {ML::Loss::MeanAbsolute, ML::Loss::Huber, ML::Loss::BinaryCrossEntropy, ML::Loss::CategoricalCrossEntropy})
+    {
+        ML::computeLoss(loss, sums.size(), outputs.data(), sums.data(), targets.data(), gradients.data(), 0.25);
+        const std::vector<double> expected = numericGradients(loss, sums, targets);
+        for (std::size_t k = 0; k < sums.size(); ++k)
+            ASSERT_NEAR(gradients[k], expected[k], 1e-6) << ML::toString(loss) << " output " << k;
+    }
+}
+
+TEST(LossTest, MeanSquaredKeepsTheOriginalErrorAndGradient)
+{
+    const std::vector<double> outputs = {0.5, -0.25};
+    const std::vector<double> targets = {1.0, 0.0};
+    std::vector<double> gradients(2);
+
+    const double error = ML::computeLoss(ML::Loss::MeanSquared, 2, outputs.data(), nullptr, targets.data(), gradients.data());
+    ASSERT_DOUBLE_EQ(error, std::sqrt((0.25 + 0.0625) / 2.0));
+    ASSERT_DOUBLE_EQ(gradients[0], 0.5 * (1.0 - 0.25));
+    ASSERT_DOUBLE_EQ(gradients[1], 0.25 * (1.0 - 0.0625));
+}
+
+TEST(LossTest, SoftmaxCrossEntropyIsStableForLargeSums)
+{
+    const std::vector<double> sums = {1000.0, -1000.0, 999.0};
+    const std::vector<double> outputs = {1.0, -1.0, 1.0};
+    const std::vector<double> targets = {0.0, 1.0, 0.0};
+    std::vector<double> gradients(3), predictions(3);
+
+    const double loss = ML::computeLoss(ML::Loss::CategoricalCrossEntropy, 3, outputs.data(), sums.data(), targets.data(), gradients.data());
+    ASSERT_TRUE(std::isfinite(loss));
+    ASSERT_NEAR(loss, 2000.0 + std::log1p(std::exp(-1.0)), 1e-9);
+    ASSERT_NEAR(std::accumulate(gradients.begin(), gradients.end(), 0.0), 0.0, 1e-12);
+
+    ML::computePredictions(ML::Loss::CategoricalCrossEntropy, 3, outputs.data(), sums.data(), predictions.data());
+    ASSERT_NEAR(predictions[0], 1.0 / (1.0 + std::exp(-1.0)), 1e-12);
+    ASSERT_EQ(predictions[1], 0.0);
+
+    const double binary = ML::computeLoss(ML::Loss::BinaryCrossEntropy, 3, outputs.data(), sums.data(), targets.data(), gradients.data());
+    ASSERT_TRUE(std::isfinite(binary));
+}
+
+TEST(LossTest, SoftmaxCrossEntropyTrainsClassifier)
+{
+    // Three classes, one per quadrant of the first two, from one-hot targets
+    const std::vector<std::pair<std::vector<double>, unsigned>> samples = {
+        {{0.9, 0.8}, 0}, {{0.7, 0.9}, 0}, {{-0.8, 0.9}, 1}, {{-0.9, 0.6}, 1}, {{0.1, -0.9}, 2}, {{-0.2, -0.7}, 2}
+    };
+
+    ML::Network network({2, 6, 3}, ML::WeightInit::Xavier, 7);
+    network.setLoss(ML::Loss::CategoricalCrossEntropy);
+    ASSERT_EQ(network.getLoss(), ML::Loss::CategoricalCrossEntropy);
+
+    std::vector<double> target(3);
+    double loss = 0.0;
+    for (int epoch = 0; epoch < 300; ++epoch)
+    {
+        loss = 0.0;
+        for (const auto& [input, label] : samples)
+        {
+            std::fill(target.begin(), target.end(), 0.0);
+            target[label] = 1.0;
+            loss += network.trainStep(input, target);
+        }
+    }
+    ASSERT_LT(loss / samples.size(), 0.1);
+
+    std::vector<double> predictions;
+    for (const auto& [input, label] : samples)
+    {
+        network.feedForward(input);
+        network.getPredictions(predictions);
+        ASSERT_NEAR(std::accumulate(predictions.begin(), predictions.end(), 0.0), 1.0, 1e-12);
+        ASSERT_EQ(std::max_element(predictions.begin(), predictions.end()) - predictions.begin(), label);
+    }
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "Model.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    std::string uniqueModelPath(const std::string& name)
+    {
+        return (fs::temp_directory_path() / (name + "_" + std::to_string(ML::Random::makeSeed()) + ".tml")).string();
+    }
+
+    std::vector<double> makeInputs(std::size_t count, std::size_t numInputs)
+    {
+        ML::Random rng(9, 0);
+        std::vector<double> inputs(count * numInputs);
+        for (double& x : inputs)
+            x = rng.uniform(-1.0, 1.0);
+        return inputs;
+    }
+}
+
+TEST(MappedModelTest, MatchesNetworkAndUsesWeightsInPlace)
+{
+    ML::Model model({4, 7, 5, 3}, ML::WeightInit::Xavier, 31);
+    model.setLoss(ML::Loss::CategoricalCrossEntropy);
+    const std::string path = uniqueModelPath("mapped_match");
+    ASSERT_TRUE(model.saveMappedFile(path));
+
+    auto mapped = ML::MappedModel::open(path);
+    ASSERT_NE(mapped, nullptr);
+    ASSERT_EQ(mapped->getTopology(), model.getNetwork()->getTopology());
+    ASSERT_EQ(mapped->getLoss(), ML::Loss::CategoricalCrossEntropy);
+    ASSERT_EQ(mapped->getNumWeights(), model.getNetwork()->getNumWeights());
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped->getWeightData()) % 4096, 0u);
+
+    const std::vector<double> inputs = makeInputs(20, 4);
+    std::vector<double> batch(20 * 3);
+    mapped->feedForwardBatch(inputs.data(), 20, batch.data());
+
+    for (std::size_t i = 0; i < 20; ++i)
+    {
+        const std::vector<double> input(inputs.begin() + i * 4, inputs.begin() + (i + 1) * 4);
+        model.feedForward(input);
+        const std::vector<double> expected = model.getResult();
+        const std::vector<double> expectedPredictions = model.getPredictions();
+        const std::vector<double> single = mapped->feedForward(input);
+        const std::vector<double> predictions = mapped->predict(input);
+        for (std::size_t n = 0; n < 3; ++n)
+        {
+            ASSERT_DOUBLE_EQ(single[n], expected[n]);
+            ASSERT_DOUBLE_EQ(batch[i * 3 + n], expected[n]);
+            ASSERT_NEAR(predictions[n], expectedPredictions[n], 1e-12);
+        }
+    }
+
+    ASSERT_TRUE(mapped->feedForward({0.1, 0.2, 0.3}).empty());
+    ASSERT_TRUE(mapped->predict({0.1, 0.2, 0.3, 0.4, 0.5}).empty());
+
+    mapped.reset();
+    fs::remove(path);
+}
+
+TEST(MappedModelTest, ReplacingTheFileLeavesOpenMappingsAlone)
+{
+    ML::Model first({2, 3, 1}, ML::WeightInit::Xavier, 1);
+    ML::Model second({2, 3, 1}, ML::WeightInit::Xavier, 2);
+    const std::string path = uniqueModelPath("mapped_replace");
+
+    ASSERT_TRUE(first.saveMappedFile(path));
+    auto oldModel = ML::MappedModel::open(path);
+    ASSERT_NE(oldModel, nullptr);
+    const std::vector<double> before = oldModel->feedForward({0.3, -0.6});
+
+    ASSERT_TRUE(second.saveMappedFile(path));
+    ASSERT_FALSE(fs::exists(path + ".partial"));
+    auto newModel = ML::MappedModel::open(path);
+    ASSERT_NE(newModel, nullptr);
+
+    ASSERT_EQ(oldModel->feedForward({0.3, -0.6}), before);
+    second.feedForward({0.3, -0.6});
+    ASSERT_DOUBLE_EQ(newModel->feedForward({0.3, -0.6})[0], second.getResult()[0]);
+    ASSERT_NE(newModel->feedForward({0.3, -0.6})[0], before[0]);
+
+    fs::remove(path);
+}
+
+TEST(MappedModelTest, SharedAcrossProcesses)
+{
+    ML::Model model({3, 16, 2}, ML::WeightInit::Xavier, 77);
+    const std::string path = uniqueModelPath("mapped_shared");
+    ASSERT_TRUE(model.saveMappedFile(path));
+
+    model.feedForward({0.1, 0.2, 0.3});
+    const std::vector<double> expected = model.getResult();
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < 3; ++i)
+    {
+        const pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0)
+        {
+            auto mapped = ML::MappedModel::open(path);
+            _exit(mapped != nullptr && mapped->feedForward({0.1, 0.2, 0.3}) == expected ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+
+    for (pid_t pid : children)
+    {
+        int status = 0;
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status));
+        ASSERT_EQ(WEXITSTATUS(status), 0);
+    }
+
+    fs::remove(path);
+}
+
+TEST(MappedModelTest, RejectsBadFiles)
+{
+    ASSERT_EQ(ML::MappedModel::open(uniqueModelPath("mapped_missing")), nullptr);
+
+    // A text weights file is not a mapped model
+    ML::Model model({2, 3, 1}, ML::WeightInit::Xavier, 4);
+    const std::string textPath = uniqueModelPath("mapped_text");
+    model.saveWeightsToFile(textPath);
+    ASSERT_EQ(ML::MappedModel::open(textPath), nullptr);
+    fs::remove(textPath);
+
+    // Truncated weights
+    const std::string path = uniqueModelPath("mapped_truncated");
+    ASSERT_TRUE(model.saveMappedFile(path));
+    fs::resize_file(path, fs::file_size(path) - sizeof(double));
+    ASSERT_EQ(ML::MappedModel::open(path), nullptr);
+
+    // Corrupt topology
+    ASSERT_TRUE(model.saveMappedFile(path));
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(40);
+        const std::uint32_t wrongSize = 5;
+        file.write(reinterpret_cast<const char*>(&wrongSize), sizeof(wrongSize));
+    }
+    ASSERT_EQ(ML::MappedModel::open(path), nullptr);
+    fs::remove(path);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "AllocationHooks.h"
+#include "Model.h"
+#include <memory>
+#include <thread>
+
+TEST(MemoryTest, ReportBreaksDownLayers)
+{
+    ML::Network network({3, 5, 2}, ML::WeightInit::Xavier, 1);
+    const ML::MemoryReport report = network.getMemoryReport();
+
+    ASSERT_EQ(report.layers.size(), 3u);
+    ASSERT_EQ(report.layers[0].numNeurons, 4u);
+    ASSERT_EQ(report.layers[0].weightBytes, 4 * 5 * sizeof(double));
+    ASSERT_EQ(report.layers[1].weightBytes, 6 * 2 * sizeof(double));
+    ASSERT_EQ(report.layers[2].weightBytes, 0u);
+    ASSERT_EQ(report.weightBytes, network.getNumWeights() * sizeof(double));
+    ASSERT_EQ(report.optimizerBytes, network.getNumWeights() * sizeof(double));
+    ASSERT_EQ(report.activationBytes, (2 * (4 + 6 + 3) + 2) * sizeof(double));
+    ASSERT_EQ(report.cacheBytes, 0u);
+
+    // Every byte of the arena is accounted for somewhere
+    ASSERT_GE(report.total(), network.getArenaBytes() + sizeof(ML::Network));
+
+    std::size_t layerTotal = 0;
+    for (const ML::LayerMemory& layer : report.layers)
+        layerTotal += layer.total();
+    ASSERT_LT(layerTotal, report.total());
+
+    const std::string table = ML::formatMemoryReport(report);
+    ASSERT_NE(table.find("activations"), std::string::npos);
+    ASSERT_NE(table.find(std::to_string(report.total())), std::string::npos);
+}
+
+TEST(MemoryTest, ReportMatchesCountedAllocations)
+{
+    // Everything the network holds on the heap was allocated while building it, so the
+    // report can't claim more than that; anything it misses would show as a shortfall
+    ML::AllocationCounter counter;
+    auto network = std::make_unique<ML::Network>(std::vector<unsigned>{8, 32, 16, 4}, ML::WeightInit::Xavier, 2);
+    const std::size_t allocated = counter.get().bytes;
+    const ML::MemoryReport report = network->getMemoryReport();
+
+    ASSERT_LE(report.total(), allocated);
+    ASSERT_GE(report.total(), allocated * 9 / 10);
+}
+
+TEST(MemoryTest, MixedPrecisionAndCachesShowUp)
+{
+    ML::Network network({4, 6, 2}, ML::WeightInit::Xavier, 3);
+    const ML::MemoryReport before = network.getMemoryReport();
+
+    network.setPrecision(ML::Precision::Mixed);
+    const ML::MemoryReport mixed = network.getMemoryReport();
+    ASSERT_EQ(mixed.cacheBytes, network.getNumWeights() * sizeof(float));
+    ASSERT_EQ(mixed.activationBytes - before.activationBytes, 2 * (5 + 7 + 3) * sizeof(float));
+
+    network.setWeightNorm(true);
+    ASSERT_EQ(network.getMemoryReport().weightBytes - mixed.weightBytes, (network.getNumWeights() + 6 + 2) * sizeof(double));
+
+    ML::Model model({4, 6, 2}, ML::WeightInit::Xavier, 3);
+    const std::size_t modelCache = model.getMemoryReport().cacheBytes;
+    model.getWeights();
+    ASSERT_EQ(model.getMemoryReport().cacheBytes - modelCache, model.getNetwork()->getNumWeights() * sizeof(double));
+}
+
+TEST(MemoryTest, CountsAllocationsPerCall)
+{
+    ASSERT_TRUE(ML::allocationHooksInstalled());
+
+    const ML::AllocationStats vectorStats = ML::countAllocations([] { std::vector<double> values(100); });
+    ASSERT_EQ(vectorStats.allocations, 1u);
+    ASSERT_EQ(vectorStats.deallocations, 1u);
+    ASSERT_EQ(vectorStats.bytes, 100 * sizeof(double));
+
+    // Another thread's allocations are its own
+    ML::AllocationCounter counter;
+    std::thread([] { std::vector<int> values(1000); }).join();
+    ASSERT_LT(counter.get().bytes, 1000 * sizeof(int));
+
+    ML::Network network({4, 16, 3}, ML::WeightInit::Xavier, 4);
+    const std::vector<double> input = {0.1, 0.2, 0.3, 0.4}, target = {0.0, 1.0, 0.0};
+    network.trainStep(input.data(), target.data());
+
+    ASSERT_EQ(ML::countAllocations([&] { network.trainStep(input.data(), target.data()); }).allocations, 0u);
+    ASSERT_EQ(ML::countAllocations([&] { network.backPropagate(target); }).allocations, 0u);
+
+    ML::Network wide({10000, 16, 3}, ML::WeightInit::Xavier, 5);
+    const ML::SparseInput sparse = {{7, 4096, 9999}, {1.0, 0.5, 1.0}};
+    wide.trainStepSparse(sparse, target);
+    ASSERT_EQ(ML::countAllocations([&] { wide.trainStepSparse(sparse, target); }).allocations, 0u);
+
+    // feedForward takes its inputs by value, so an lvalue argument costs one copy
+    const ML::AllocationStats forward = ML::countAllocations([&] { network.feedForward(input); });
+    ASSERT_EQ(forward.allocations, 1u);
+    ASSERT_EQ(forward.bytes, input.size() * sizeof(double));
+}
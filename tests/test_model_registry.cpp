@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "Model.h"
+#include "ModelRegistry.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    fs::path makeTempDirectory(const std::string& name)
+    {
+        fs::path dir = fs::temp_directory_path() / (name + "_" + std::to_string(ML::Random::makeSeed()));
+        fs::create_directories(dir);
+        return dir;
+    }
+
+    // Deploy the way the registry expects: write aside, then rename into place
+    void deploy(ML::Model& model, const fs::path& path, int secondsFromNow)
+    {
+        fs::path staging = path.string() + ".tmp";
+        model.saveWeightsToFile(staging.string());
+        fs::last_write_time(staging, fs::file_time_type::clock::now() + std::chrono::seconds(secondsFromNow));
+        fs::rename(staging, path);
+    }
+}
+
+TEST(ModelRegistryTest, LoadWeightsRejectsMismatchedCounts)
+{
+    fs::path dir = makeTempDirectory("tinyml_load");
+    ML::Model small({2, 2, 1}, ML::WeightInit::Xavier, 1);
+    ML::Model large({2, 3, 1}, ML::WeightInit::Xavier, 2);
+    small.saveWeightsToFile((dir / "small.txt").string());
+
+    const std::vector<double> before = large.getWeights();
+    ASSERT_FALSE(large.loadWeightsFromFile((dir / "small.txt").string()));
+    ASSERT_EQ(large.getWeights(), before);
+
+    ML::Model copy({2, 2, 1});
+    ASSERT_TRUE(copy.loadWeightsFromFile((dir / "small.txt").string()));
+    ASSERT_EQ(copy.getWeights(), small.getWeights());
+
+    fs::remove_all(dir);
+}
+
+TEST(ModelRegistryTest, SwapsInNewerValidModelsOnly)
+{
+    const std::vector<unsigned> topology = {2, 3, 1};
+    fs::path dir = makeTempDirectory("tinyml_registry");
+    ML::ModelRegistry registry(topology, dir);
+
+    ASSERT_FALSE(registry.poll());
+    ASSERT_TRUE(registry.feedForward({0.5, 0.5}).empty());
+
+    ML::Model first(topology, ML::WeightInit::Xavier, 10);
+    deploy(first, dir / "v1.txt", 1);
+    ASSERT_TRUE(registry.poll());
+    ASSERT_FALSE(registry.poll()); // unchanged directory
+
+    first.feedForward({0.5, 0.5});
+    ASSERT_EQ(registry.feedForward({0.5, 0.5}), first.getResult());
+
+    // A model for the wrong topology is rejected and the old one keeps serving
+    auto pinned = registry.acquire();
+    ML::Model wrong({2, 5, 1}, ML::WeightInit::Xavier, 11);
+    deploy(wrong, dir / "v2.txt", 2);
+    ASSERT_FALSE(registry.poll());
+    ASSERT_EQ(registry.getCurrentPath(), dir / "v1.txt");
+
+    ML::Model second(topology, ML::WeightInit::Xavier, 12);
+    deploy(second, dir / "v3.txt", 3);
+    ASSERT_TRUE(registry.poll());
+    ASSERT_EQ(registry.getCurrentPath(), dir / "v3.txt");
+
+    second.feedForward({0.5, 0.5});
+    ASSERT_EQ(registry.feedForward({0.5, 0.5}), second.getResult());
+    ASSERT_EQ(pinned->feedForward({0.5, 0.5}), first.getResult()); // in-flight readers keep their model
+
+    fs::remove_all(dir);
+}
+
+TEST(ModelRegistryTest, BackgroundWatcherPicksUpDeployments)
+{
+    const std::vector<unsigned> topology = {2, 2, 1};
+    fs::path dir = makeTempDirectory("tinyml_watch");
+    ML::ModelRegistry registry(topology, dir, ".txt", std::chrono::milliseconds(5));
+    registry.start();
+
+    ML::Model model(topology, ML::WeightInit::Xavier, 5);
+    deploy(model, dir / "model.txt", 1);
+
+    for (int i = 0; i < 400 && registry.getNumReloads() == 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    registry.stop();
+    ASSERT_EQ(registry.getNumReloads(), 1u);
+
+    model.feedForward({1.0, 0.0});
+    ASSERT_EQ(registry.feedForward({1.0, 0.0}), model.getResult());
+
+    fs::remove_all(dir);
+}
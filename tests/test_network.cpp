@@ -0,0 +1,518 @@
+#include <gtest/gtest.h>
+#include "Network.h"
+#include <algorithm>
+#include <cmath>
+
+// Storage
+
+TEST(NetworkTest, ArenaSizedFromTopology)
+{
+    std::vector<unsigned> topology = {4, 8, 3};
+    ML::Network network(topology);
+
+    ASSERT_EQ(network.getArenaBytes(), ML::Network::requiredBytes(topology));
+    ASSERT_EQ(network.getNumWeights(), 5u * 8u + 9u * 3u);
+    ASSERT_EQ(ML::Network::countWeights(topology), network.getNumWeights());
+    ASSERT_EQ(ML::Network::layerWeightOffsets(topology), (std::vector<std::size_t>{0, 40, 67}));
+    ASSERT_EQ(network.getWeights().size(), network.getNumWeights());
+}
+
+TEST(NetworkTest, SetTopologyReusesStorageWhenItFits)
+{
+    ML::Network network({16, 16, 4});
+    const std::size_t bytes = network.getArenaBytes();
+
+    network.setTopology({2, 3, 1});
+    ASSERT_EQ(network.getArenaBytes(), bytes);
+    ASSERT_EQ(network.GetLayers().size(), 3u);
+    ASSERT_EQ(network.getNumWeights(), 3u * 3u + 4u * 1u);
+
+    network.setTopology({32, 32, 4});
+    ASSERT_GE(network.getArenaBytes(), ML::Network::requiredBytes({32, 32, 4}));
+}
+
+TEST(NetworkTest, WeightsRoundTripWithoutDisturbingNetwork)
+{
+    ML::Network network({3, 4, 2});
+
+    std::vector<double> weights(network.getNumWeights());
+    for (std::size_t i = 0; i < weights.size(); ++i)
+        weights[i] = 0.01 * static_cast<double>(i);
+
+    network.putWeights(weights);
+    ASSERT_EQ(network.getWeights(), weights);
+    ASSERT_EQ(network.getWeights(), weights); // reading must not consume the weights
+
+    // Row i of a layer's weights belongs to source neuron i
+    auto& layers = network.GetLayers();
+    ASSERT_DOUBLE_EQ(layers[0][1].getOutputWeights()[2], weights[1 * 4 + 2]);
+    ASSERT_DOUBLE_EQ(layers[1][0].getOutputWeights()[1], weights[4 * 4 + 1]);
+}
+
+TEST(NetworkTest, FeedForwardMatchesNeuronByNeuronEvaluation)
+{
+    ML::Network network({3, 5, 2});
+    std::vector<double> input = {0.3, -0.7, 0.9};
+    network.feedForward(input);
+
+    std::vector<double> results;
+    network.getResults(results);
+
+    // Re-run the same pass through the per-neuron API and compare
+    auto& layers = network.GetLayers();
+    for (std::size_t layerNum = 1; layerNum < layers.size(); ++layerNum)
+        for (std::size_t n = 0; n < layers[layerNum].size() - 1; ++n)
+            layers[layerNum][n].feedForward(layers[layerNum - 1]);
+
+    for (std::size_t n = 0; n < results.size(); ++n)
+        ASSERT_DOUBLE_EQ(results[n], layers.back()[n].getOutputVal());
+}
+
+// Weight initialisation
+
+TEST(NetworkTest, SameSeedGivesSameWeights)
+{
+    ML::Network a({4, 6, 2}, ML::WeightInit::Uniform, 1234);
+    ML::Network b({4, 6, 2}, ML::WeightInit::Uniform, 1234);
+    ML::Network c({4, 6, 2}, ML::WeightInit::Uniform, 1235);
+
+    ASSERT_EQ(a.getWeights(), b.getWeights());
+    ASSERT_NE(a.getWeights(), c.getWeights());
+}
+
+TEST(NetworkTest, DefaultSeedsDifferBetweenNetworks)
+{
+    ML::Network a({4, 6, 2});
+    ML::Network b({4, 6, 2});
+
+    ASSERT_NE(a.getSeed(), b.getSeed());
+    ASSERT_NE(a.getWeights(), b.getWeights());
+}
+
+TEST(NetworkTest, XavierAndHeRespectTheirBounds)
+{
+    ML::Network xavier({20, 30, 10}, ML::WeightInit::Xavier, 7);
+    ML::Network he({20, 30, 10}, ML::WeightInit::He, 7);
+
+    auto& xavierLayers = xavier.GetLayers();
+    auto& heLayers = he.GetLayers();
+
+    for (std::size_t layerNum = 0; layerNum + 1 < xavierLayers.size(); ++layerNum)
+    {
+        const double fanIn = xavier.getTopology()[layerNum];
+        const double fanOut = xavier.getTopology()[layerNum + 1];
+        const double xavierLimit = std::sqrt(6.0 / (fanIn + fanOut));
+        const double heLimit = std::sqrt(6.0 / fanIn);
+        const std::size_t count = xavierLayers[layerNum].size() * xavierLayers[layerNum].getNumOutputs();
+
+        bool anyNegative = false;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ASSERT_LE(std::abs(xavierLayers[layerNum].getOutputWeights()[i]), xavierLimit);
+            ASSERT_LE(std::abs(heLayers[layerNum].getOutputWeights()[i]), heLimit);
+            anyNegative = anyNegative || xavierLayers[layerNum].getOutputWeights()[i] < 0.0;
+        }
+        ASSERT_TRUE(anyNegative);
+    }
+}
+
+TEST(NetworkTest, LargeNetworkInitialisationIsReproducible)
+{
+    // Large enough to be initialised in parallel chunks
+    ML::Network a({512, 512, 256}, ML::WeightInit::Xavier, 42);
+    ML::Network b({512, 512, 256}, ML::WeightInit::Xavier, 42);
+    ASSERT_EQ(a.getWeights(), b.getWeights());
+
+    b.initialiseWeights(ML::WeightInit::Xavier, 43);
+    ASSERT_NE(a.getWeights(), b.getWeights());
+    b.initialiseWeights(ML::WeightInit::Xavier, 42);
+    ASSERT_EQ(a.getWeights(), b.getWeights());
+}
+
+// Incremental forward pass
+
+TEST(NetworkTest, IncrementalForwardTracksFullForward)
+{
+    ML::Network incremental({64, 32, 8}, ML::WeightInit::Xavier, 7);
+    ML::Network reference({64, 32, 8}, ML::WeightInit::Xavier, 7);
+
+    std::vector<double> input(64);
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = std::sin(0.1 * i);
+    }
+
+    std::vector<double> expected, actual;
+    for (int step = 0; step < 200; ++step)
+    {
+        // Nudge a few features per tick, as a slider-driven UI would
+        input[(step * 7) % 64] += 0.01 * step;
+        input[(step * 13) % 64] -= 0.02;
+
+        incremental.feedForwardIncremental(input);
+        reference.feedForward(input);
+        incremental.getResults(actual);
+        reference.getResults(expected);
+
+        for (std::size_t n = 0; n < expected.size(); ++n)
+        {
+            ASSERT_NEAR(actual[n], expected[n], 1e-12);
+        }
+    }
+}
+
+TEST(NetworkTest, IncrementalForwardSeesWeightUpdates)
+{
+    ML::Network incremental({2, 6, 1}, ML::WeightInit::Xavier, 3);
+    ML::Network reference({2, 6, 1}, ML::WeightInit::Xavier, 3);
+    std::vector<double> expected, actual;
+
+    for (int epoch = 0; epoch < 20; ++epoch)
+    {
+        const std::vector<double> input = {0.5, 0.05 * epoch};
+        incremental.feedForwardIncremental(input);
+        reference.feedForward(input);
+        incremental.getResults(actual);
+        reference.getResults(expected);
+        ASSERT_EQ(actual, expected); // every call after training is a full rebuild
+
+        incremental.backPropagate({0.25});
+        reference.backPropagate({0.25});
+    }
+}
+
+// Weight normalisation
+
+namespace
+{
+    // Incoming (non-bias) weights of neuron n in the layer after layerNum
+    std::vector<double> incomingWeights(const ML::Network& network, std::size_t layerNum, std::size_t n)
+    {
+        const ML::Layer& layer = network.layers[layerNum];
+        std::vector<double> column;
+        for (std::size_t i = 0; i + 1 < layer.size(); ++i)
+        {
+            column.push_back(layer.getOutputWeights()[i * layer.getNumOutputs() + n]);
+        }
+        return column;
+    }
+
+    double mean(const std::vector<double>& values)
+    {
+        double sum = 0.0;
+        for (double v : values)
+            sum += v;
+        return sum / values.size();
+    }
+
+    double norm(const std::vector<double>& values)
+    {
+        double sum = 0.0;
+        for (double v : values)
+            sum += v * v;
+        return std::sqrt(sum);
+    }
+}
+
+TEST(NetworkTest, NormalizePerNeuronCentresAndScalesEachNeuron)
+{
+    ML::Network network({5, 7, 3}, ML::WeightInit::Uniform, 4);
+    const double bias = network.layers[0].back().getOutputWeights()[0];
+
+    network.normalizeWeights(ML::NormScope::PerNeuron, true, 2.0);
+
+    for (std::size_t layerNum = 0; layerNum < 2; ++layerNum)
+    {
+        for (std::size_t n = 0; n < network.getTopology()[layerNum + 1]; ++n)
+        {
+            const std::vector<double> column = incomingWeights(network, layerNum, n);
+            ASSERT_NEAR(mean(column), 0.0, 1e-12);
+            ASSERT_NEAR(norm(column), 2.0, 1e-12);
+        }
+    }
+    ASSERT_EQ(network.layers[0].back().getOutputWeights()[0], bias);
+}
+
+TEST(NetworkTest, NormalizePerLayerWithoutCentringKeepsDirection)
+{
+    ML::Network network({4, 6, 2}, ML::WeightInit::Xavier, 8);
+    const std::vector<double> before = network.getWeights();
+
+    network.normalizeWeights(ML::NormScope::PerLayer, false);
+
+    // Layer 0's non-bias weights are the first 4 * 6; all scaled by one factor to unit norm
+    std::vector<double> layerWeights(network.getWeightData(), network.getWeightData() + 24);
+    ASSERT_NEAR(norm(layerWeights), 1.0, 1e-12);
+    const double factor = layerWeights[0] / before[0];
+    for (std::size_t k = 0; k < 24; ++k)
+    {
+        ASSERT_NEAR(layerWeights[k], before[k] * factor, 1e-12);
+    }
+}
+
+TEST(NetworkTest, NormalizeSingleConnectionKeepsNetworkUsable)
+{
+    ML::Network network({3, 4, 2}, ML::WeightInit::Uniform, 6);
+    network.normalizeWeights(1);
+
+    ASSERT_EQ(network.getNumWeights(), 4u * 4 + 5u * 2);
+    for (double w : network.getWeights())
+    {
+        ASSERT_TRUE(std::isfinite(w));
+    }
+
+    network.feedForward({0.1, 0.2, 0.3});
+    std::vector<double> results;
+    network.getResults(results);
+    ASSERT_EQ(results.size(), 2u);
+}
+
+TEST(NetworkTest, WeightNormTrainsGainAndDirection)
+{
+    ML::Network network({2, 8, 1}, ML::WeightInit::Xavier, 12);
+    network.setWeightNorm(true);
+    ASSERT_EQ(network.getWeightNormGains().size(), 9u);
+    const std::vector<double> initialGains = network.getWeightNormGains();
+
+    double firstError = 0.0, lastError = 0.0;
+    std::vector<double> result;
+    for (int epoch = 0; epoch < 300; ++epoch)
+    {
+        network.feedForward({0.4, -0.6});
+        network.getResults(result);
+        const double error = std::abs(result[0] - 0.5);
+        firstError = epoch == 0 ? error : firstError;
+        lastError = error;
+        network.backPropagate({0.5});
+    }
+
+    ASSERT_LT(lastError, firstError);
+    ASSERT_NE(network.getWeightNormGains(), initialGains);
+
+    // Every neuron's incoming weights have exactly the length of its gain
+    std::size_t gain = 0;
+    for (std::size_t layerNum = 0; layerNum < 2; ++layerNum)
+    {
+        for (std::size_t n = 0; n < network.getTopology()[layerNum + 1]; ++n, ++gain)
+        {
+            ASSERT_NEAR(norm(incomingWeights(network, layerNum, n)), std::abs(network.getWeightNormGains()[gain]), 1e-12);
+        }
+    }
+}
+
+// Mixed precision
+
+TEST(NetworkTest, MixedForwardIsCloseToDouble)
+{
+    ML::Network mixed({16, 32, 8}, ML::WeightInit::Xavier, 2);
+    ML::Network reference({16, 32, 8}, ML::WeightInit::Xavier, 2);
+    mixed.setPrecision(ML::Precision::Mixed);
+
+    std::vector<double> input(16), expected, actual;
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = std::cos(0.3 * i);
+    }
+
+    mixed.feedForward(input);
+    reference.feedForward(input);
+    mixed.getResults(actual);
+    reference.getResults(expected);
+
+    for (std::size_t n = 0; n < expected.size(); ++n)
+    {
+        ASSERT_NEAR(actual[n], expected[n], 1e-5);
+    }
+}
+
+TEST(NetworkTest, MixedTrainingConvergesLikeDouble)
+{
+    // The gate tasks from the perceptron tests, trained in both precisions from the same start
+    const std::vector<std::pair<std::vector<double>, double>> xorGate = {
+        {{0, 0}, 0}, {{0, 1}, 1}, {{1, 0}, 1}, {{1, 1}, 0}
+    };
+
+    ML::Network mixed({2, 4, 1}, ML::WeightInit::Xavier, 31);
+    ML::Network reference({2, 4, 1}, ML::WeightInit::Xavier, 31);
+    mixed.setPrecision(ML::Precision::Mixed);
+
+    for (int epoch = 0; epoch < 5000; ++epoch)
+    {
+        for (const auto& [input, target] : xorGate)
+        {
+            mixed.feedForward(input);
+            mixed.backPropagate({target});
+            reference.feedForward(input);
+            reference.backPropagate({target});
+        }
+    }
+
+    std::vector<double> mixedResult, referenceResult;
+    for (const auto& [input, target] : xorGate)
+    {
+        mixed.feedForward(input);
+        reference.feedForward(input);
+        mixed.getResults(mixedResult);
+        reference.getResults(referenceResult);
+
+        ASSERT_NEAR(referenceResult[0], target, 0.1);
+        ASSERT_NEAR(mixedResult[0], referenceResult[0], 1e-3);
+    }
+
+    // The optimizer keeps double master weights rather than float-rounded ones
+    bool anyBeyondFloat = false;
+    for (double w : mixed.getWeights())
+    {
+        anyBeyondFloat = anyBeyondFloat || w != static_cast<double>(static_cast<float>(w));
+    }
+    ASSERT_TRUE(anyBeyondFloat);
+}
+
+// Fused training step
+
+TEST(NetworkTest, TrainStepMatchesFeedForwardAndBackPropagate)
+{
+    ML::Network fused({3, 5, 4, 2}, ML::WeightInit::Xavier, 41);
+    ML::Network separate({3, 5, 4, 2}, ML::WeightInit::Xavier, 41);
+    const std::vector<std::vector<double>> inputs = {{0.1, -0.4, 0.9}, {1.0, 0.0, -1.0}, {0.3, 0.3, 0.3}};
+    const std::vector<std::vector<double>> targets = {{0.5, -0.5}, {0.0, 1.0}, {-0.2, 0.2}};
+
+    for (int step = 0; step < 30; ++step)
+    {
+        const std::size_t s = step % inputs.size();
+        const double loss = fused.trainStep(inputs[s], targets[s]);
+        separate.feedForward(inputs[s]);
+        separate.backPropagate(targets[s]);
+
+        ASSERT_EQ(fused.getWeights(), separate.getWeights());
+        ASSERT_EQ(fused.getRecentAverageError(), separate.getRecentAverageError());
+        ASSERT_GE(loss, 0.0);
+    }
+}
+
+TEST(NetworkTest, TrainStepFollowsPlainBackPropagation)
+{
+    // Reference: every activation, then every gradient, then every update, as separate passes
+    const std::vector<unsigned> topology = {2, 3, 2};
+    ML::Network network(topology, ML::WeightInit::Xavier, 43);
+    std::vector<double> w = network.getWeights();
+    std::vector<double> dw(w.size(), 0.0);
+    const std::vector<double> input = {0.7, -0.3};
+    const std::vector<double> target = {0.2, -0.6};
+
+    for (int step = 0; step < 3; ++step)
+    {
+        std::vector<std::vector<double>> vals(topology.size()), grads(topology.size());
+        vals[0] = {input[0], input[1], 0.0};
+        std::size_t offset = 0;
+        std::vector<std::size_t> offsets;
+        for (std::size_t l = 1; l < topology.size(); ++l)
+        {
+            offsets.push_back(offset);
+            vals[l].assign(topology[l] + 1, 0.0);
+            for (unsigned n = 0; n < topology[l]; ++n)
+            {
+                double sum = 0.0;
+                for (unsigned i = 0; i <= topology[l - 1]; ++i)
+                    sum += vals[l - 1][i] * w[offset + i * topology[l] + n];
+                vals[l][n] = std::tanh(sum);
+            }
+            offset += (topology[l - 1] + 1) * topology[l];
+        }
+
+        double expectedLoss = 0.0;
+        grads.back().assign(topology.back(), 0.0);
+        for (unsigned n = 0; n < topology.back(); ++n)
+        {
+            const double delta = target[n] - vals.back()[n];
+            expectedLoss += delta * delta;
+            grads.back()[n] = delta * (1.0 - vals.back()[n] * vals.back()[n]);
+        }
+        expectedLoss = std::sqrt(expectedLoss / topology.back());
+
+        for (std::size_t l = topology.size() - 2; l > 0; --l)
+        {
+            grads[l].assign(topology[l] + 1, 0.0);
+            for (unsigned i = 0; i <= topology[l]; ++i)
+            {
+                double dow = 0.0;
+                for (unsigned n = 0; n < topology[l + 1]; ++n)
+                    dow += w[offsets[l] + i * topology[l + 1] + n] * grads[l + 1][n];
+                grads[l][i] = dow * (1.0 - vals[l][i] * vals[l][i]);
+            }
+        }
+
+        for (std::size_t l = 1; l < topology.size(); ++l)
+            for (unsigned i = 0; i <= topology[l - 1]; ++i)
+                for (unsigned n = 0; n < topology[l]; ++n)
+                {
+                    const std::size_t k = offsets[l - 1] + i * topology[l] + n;
+                    dw[k] = ML::Neuron::eta * vals[l - 1][i] * grads[l][n] + ML::Neuron::alpha * dw[k];
+                    w[k] += dw[k];
+                }
+
+        ASSERT_NEAR(network.trainStep(input.data(), target.data()), expectedLoss, 1e-12);
+        const std::vector<double> actual = network.getWeights();
+        for (std::size_t k = 0; k < w.size(); ++k)
+            ASSERT_NEAR(actual[k], w[k], 1e-12);
+    }
+}
+
+TEST(NetworkTest, LearningRateScalesEveryUpdatePath)
+{
+    const std::vector<double> input = {0.6, -0.2, 0.9};
+    const std::vector<double> target = {0.3, -0.7};
+
+    // From zero momentum one step moves each weight by learningRate times the gradient,
+    // so doubling the rate doubles the step on every path
+    auto step = [&] (double learningRate, int path)
+    {
+        ML::Network network({3, 4, 2}, ML::WeightInit::Xavier, 51);
+        network.setLearningRate(learningRate);
+        network.setMomentum(0.0);
+        const std::vector<double> before = network.getWeights();
+
+        if (path == 0)
+        {
+            network.trainStep(input, target);
+        }
+        else if (path == 1)
+        {
+            network.setPrecision(ML::Precision::Mixed);
+            network.trainStep(input, target);
+        }
+        else if (path == 2)
+        {
+            network.trainStepSparse(ML::SparseInput{{0, 1, 2}, input}, target);
+        }
+        else
+        {
+            std::vector<double> gradient(network.getNumWeights(), 0.0);
+            network.accumulateGradient(input.data(), target.data(), gradient.data());
+            network.applyGradient(gradient.data());
+        }
+
+        std::vector<double> delta = network.getWeights();
+        for (std::size_t w = 0; w < delta.size(); ++w)
+            delta[w] -= before[w];
+        return delta;
+    };
+
+    for (int path = 0; path < 4; ++path)
+    {
+        const std::vector<double> base = step(ML::Neuron::eta, path);
+        const std::vector<double> doubled = step(2.0 * ML::Neuron::eta, path);
+        double largest = 0.0;
+        for (std::size_t w = 0; w < base.size(); ++w)
+        {
+            ASSERT_NEAR(doubled[w], 2.0 * base[w], 1e-12) << "path " << path;
+            largest = std::max(largest, std::abs(base[w]));
+        }
+        ASSERT_GT(largest, 0.0);
+        ASSERT_TRUE(step(0.0, path) == std::vector<double>(base.size(), 0.0));
+    }
+
+    ML::Network defaults({2, 1});
+    ASSERT_EQ(defaults.getLearningRate(), ML::Neuron::eta);
+    ASSERT_EQ(defaults.getMomentum(), ML::Neuron::alpha);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "PipelineExecutor.h"
+#include "SpscQueue.h"
+#include <cmath>
+#include <thread>
+
+TEST(PipelineExecutorTest, SpscQueueKeepsOrderAcrossThreads)
+{
+    ML::SpscQueue<int> queue(8);
+    ASSERT_EQ(queue.capacity(), 8u);
+    const int count = 20000;
+
+    std::thread producer([&]
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            int value = i;
+            while (!queue.tryPush(value))
+                std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    while (expected < count)
+    {
+        int value;
+        if (queue.tryPop(value))
+        {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    int leftover;
+    ASSERT_FALSE(queue.tryPop(leftover));
+}
+
+TEST(PipelineExecutorTest, StagesCoverEveryLayerInOrder)
+{
+    ML::Network network({4, 16, 16, 16, 16, 16, 2}, ML::WeightInit::Xavier, 1);
+    ML::PipelineExecutor pipeline(network, 3);
+
+    ASSERT_EQ(pipeline.getNumStages(), 3u);
+    const std::vector<std::size_t> boundaries = pipeline.getStageBoundaries();
+    ASSERT_EQ(boundaries.front(), 1u);
+    for (std::size_t s = 1; s < boundaries.size(); ++s)
+    {
+        ASSERT_GT(boundaries[s], boundaries[s - 1]);
+    }
+    ASSERT_LT(boundaries.back(), 7u);
+
+    // More stages than layers collapses to one stage per layer
+    ML::PipelineExecutor wide(network, 64);
+    ASSERT_EQ(wide.getNumStages(), 6u);
+}
+
+TEST(PipelineExecutorTest, ResultsMatchNetworkFromManyThreads)
+{
+    ML::Network network({3, 12, 12, 12, 12, 2}, ML::WeightInit::Xavier, 5);
+    ML::PipelineExecutor pipeline(network, 4, 4);
+
+    const int numThreads = 4, perThread = 300;
+    std::vector<std::thread> clients;
+    std::vector<int> mismatches(numThreads, 0);
+
+    for (int t = 0; t < numThreads; ++t)
+    {
+        clients.emplace_back([&, t]
+        {
+            std::vector<std::future<std::vector<double>>> futures;
+            std::vector<std::vector<double>> inputs;
+            for (int i = 0; i < perThread; ++i)
+            {
+                inputs.push_back({std::sin(0.1 * i + t), std::cos(0.2 * i), 0.01 * t});
+                futures.push_back(pipeline.submit(inputs.back()));
+            }
+
+            std::vector<double> expected(2);
+            for (int i = 0; i < perThread; ++i)
+            {
+                ML::Network::feedForward(network.getTopology(), network.getWeightData(), inputs[i].data(), expected.data());
+                mismatches[t] += futures[i].get() != expected;
+            }
+        });
+    }
+
+    for (auto& client : clients)
+        client.join();
+
+    for (int t = 0; t < numThreads; ++t)
+        ASSERT_EQ(mismatches[t], 0);
+}
+
+TEST(PipelineExecutorTest, DestructorFinishesQueuedSamples)
+{
+    ML::Network network({2, 8, 8, 1}, ML::WeightInit::Xavier, 2);
+    std::vector<std::future<std::vector<double>>> futures;
+    {
+        ML::PipelineExecutor pipeline(network, 3);
+        for (int i = 0; i < 200; ++i)
+            futures.push_back(pipeline.submit({0.01 * i, -0.5}));
+    }
+
+    for (auto& future : futures)
+        ASSERT_EQ(future.get().size(), 1u);
+}
+
+TEST(PipelineExecutorTest, WrongInputSizeThrows)
+{
+    ML::Network network({2, 4, 1}, ML::WeightInit::Xavier, 3);
+    ML::PipelineExecutor pipeline(network);
+    auto future = pipeline.submit({1.0, 2.0, 3.0});
+    ASSERT_THROW(future.get(), std::invalid_argument);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "Snapshot.h"
+#include <atomic>
+#include <thread>
+
+TEST(SnapshotTest, EmptyUntilFirstPublish)
+{
+    ML::SnapshotPublisher publisher;
+    ASSERT_FALSE(publisher.acquire());
+}
+
+TEST(SnapshotTest, SnapshotMatchesNetworkAtPublishTime)
+{
+    ML::Network network({2, 4, 1}, ML::WeightInit::Xavier, 3);
+    ML::SnapshotPublisher publisher;
+    ASSERT_EQ(publisher.publish(network), 1u);
+
+    std::vector<double> input = {0.25, -0.5};
+    network.feedForward(input);
+    std::vector<double> expected;
+    network.getResults(expected);
+
+    // Training after publishing must not leak into the published snapshot
+    network.backPropagate({1.0});
+
+    auto snapshot = publisher.acquire();
+    ASSERT_TRUE(snapshot);
+    ASSERT_EQ(snapshot->getVersion(), 1u);
+    ASSERT_EQ(snapshot->feedForward(input), expected);
+}
+
+TEST(SnapshotTest, ReadersNeverSeeTornWeights)
+{
+    const std::vector<unsigned> topology = {8, 16, 4};
+    ML::Network network(topology);
+    std::vector<double> weights(network.getNumWeights());
+    ML::SnapshotPublisher publisher;
+
+    std::atomic<bool> done { false };
+    std::atomic<int> torn { 0 };
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&]
+        {
+            while (!done.load())
+            {
+                auto snapshot = publisher.acquire();
+                if (!snapshot)
+                    continue;
+
+                // Every publish writes a single value to all weights
+                const auto& w = snapshot->getWeights();
+                for (double value : w)
+                    if (value != w.front())
+                        ++torn;
+            }
+        });
+    }
+
+    for (int version = 1; version <= 2000; ++version)
+    {
+        std::fill(weights.begin(), weights.end(), static_cast<double>(version));
+        network.putWeights(weights);
+        publisher.publish(network);
+    }
+
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_EQ(publisher.acquire()->getWeights().front(), 2000.0);
+
+    // With every reader gone, the next publish reclaims all retired snapshots
+    publisher.publish(network);
+    ASSERT_EQ(publisher.getNumRetired(), 0u);
+}
+
+TEST(SnapshotTest, HeldSnapshotOutlivesLaterPublishes)
+{
+    ML::Network network({2, 2, 1}, ML::WeightInit::Uniform, 11);
+    ML::SnapshotPublisher publisher;
+    publisher.publish(network);
+
+    auto held = publisher.acquire();
+    const std::vector<double> heldWeights = held->getWeights();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        network.feedForward({1.0, 0.0});
+        network.backPropagate({1.0});
+        publisher.publish(network);
+    }
+
+    ASSERT_GT(publisher.getNumRetired(), 0u);
+    ASSERT_EQ(held->getWeights(), heldWeights);
+    ASSERT_EQ(held->getVersion(), 1u);
+    ASSERT_EQ(publisher.acquire()->getVersion(), 11u);
+}
+
+TEST(SnapshotTest, RejectsWrongInputSize)
+{
+    ML::Network network({3, 4, 2}, ML::WeightInit::Xavier, 5);
+    ML::SnapshotPublisher publisher;
+    publisher.publish(network);
+
+    auto snapshot = publisher.acquire();
+    ASSERT_TRUE(snapshot->feedForward({0.5, 0.5}).empty());
+    ASSERT_TRUE(snapshot->feedForward({0.5, 0.5, 0.5, 0.5}).empty());
+    ASSERT_EQ(snapshot->feedForward({0.5, 0.5, 0.5}).size(), 2u);
+    ASSERT_TRUE(ML::WeightSnapshot().feedForward({0.5}).empty());
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "Sparse.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    std::size_t countZeros(const ML::Network& network)
+    {
+        std::size_t zeros = 0;
+        for (std::size_t i = 0; i < network.getNumWeights(); ++i)
+        {
+            zeros += network.getWeightData()[i] == 0.0;
+        }
+        return zeros;
+    }
+
+    std::vector<double> denseResult(ML::Network& network, const std::vector<double>& input)
+    {
+        network.feedForward(input);
+        std::vector<double> result;
+        network.getResults(result);
+        return result;
+    }
+}
+
+TEST(SparseTest, PruneByMagnitudeReachesTargetPerLayer)
+{
+    ML::Network network({16, 32, 8}, ML::WeightInit::Xavier, 11);
+    const std::size_t pruned = ML::pruneByMagnitude(network, 0.75);
+
+    // 17 * 32 = 544 and 33 * 8 = 264 weights, three quarters of each
+    ASSERT_EQ(pruned, 408u + 198u);
+    ASSERT_EQ(countZeros(network), pruned);
+}
+
+TEST(SparseTest, PruneKeepsLargestWeightsGlobally)
+{
+    ML::Network network({4, 8, 2}, ML::WeightInit::Xavier, 5);
+    std::vector<double> before = network.getWeights();
+
+    ML::pruneByMagnitude(network, 0.5, ML::PruneScope::Global);
+
+    std::vector<double> magnitudes;
+    for (double w : before)
+    {
+        magnitudes.push_back(std::abs(w));
+    }
+    std::sort(magnitudes.begin(), magnitudes.end());
+    const double cutoff = magnitudes[before.size() / 2];
+
+    for (std::size_t i = 0; i < before.size(); ++i)
+    {
+        const double w = network.getWeightData()[i];
+        if (std::abs(before[i]) > cutoff)
+        {
+            ASSERT_EQ(w, before[i]);
+        }
+        if (std::abs(before[i]) < cutoff)
+        {
+            ASSERT_EQ(w, 0.0);
+        }
+    }
+}
+
+TEST(SparseTest, PrunedWeightsStayZeroThroughTraining)
+{
+    ML::Network network({2, 8, 1}, ML::WeightInit::Xavier, 9);
+    const std::size_t pruned = ML::pruneByThreshold(network, 0.3);
+    ASSERT_GT(pruned, 0u);
+
+    for (int epoch = 0; epoch < 100; ++epoch)
+    {
+        network.feedForward({0.5, -0.25});
+        network.backPropagate({0.75});
+    }
+
+    ASSERT_EQ(countZeros(network), pruned);
+}
+
+TEST(SparseTest, PruneAndRetrainRampsToFinalSparsity)
+{
+    ML::Network network({4, 16, 2}, ML::WeightInit::He, 13);
+    unsigned retrainCalls = 0;
+
+    ML::pruneAndRetrain(network, 0.8, 4, [&](ML::Network& net)
+    {
+        ++retrainCalls;
+        net.feedForward({0.1, 0.2, 0.3, 0.4});
+        net.backPropagate({0.5, -0.5});
+    });
+
+    ASSERT_EQ(retrainCalls, 4u);
+    ASSERT_EQ(countZeros(network), 64u + 27u); // 80% of 80 and 34 weights
+}
+
+TEST(SparseTest, CsrAndDenseLayersMatchNetwork)
+{
+    ML::Network network({6, 24, 12, 3}, ML::WeightInit::Xavier, 21);
+    ML::pruneByMagnitude(network, 0.9);
+
+    ML::SparseNetwork allSparse(network, 2.0);
+    ML::SparseNetwork allDense(network, 0.0);
+    for (std::size_t layerNum = 0; layerNum < 3; ++layerNum)
+    {
+        ASSERT_TRUE(allSparse.isLayerSparse(layerNum));
+        ASSERT_FALSE(allDense.isLayerSparse(layerNum));
+        ASSERT_NEAR(allSparse.getLayerDensity(layerNum), 0.1, 0.01);
+    }
+
+    const std::vector<double> input = {0.3, -0.7, 0.1, 0.9, -0.2, 0.5};
+    const std::vector<double> expected = denseResult(network, input);
+    const std::vector<double> sparseResult = allSparse.feedForward(input);
+    const std::vector<double> denseOutput = allDense.feedForward(input);
+
+    ASSERT_EQ(denseOutput, expected);
+    for (std::size_t n = 0; n < expected.size(); ++n)
+    {
+        ASSERT_NEAR(sparseResult[n], expected[n], 1e-12);
+    }
+}
+
+TEST(SparseTest, BatchMatchesSingleSample)
+{
+    ML::Network network({5, 20, 4}, ML::WeightInit::Xavier, 17);
+    ML::pruneByMagnitude(network, 0.7);
+
+    const std::size_t batchSize = 9;
+    std::vector<double> inputs(batchSize * 5);
+    for (std::size_t k = 0; k < inputs.size(); ++k)
+    {
+        inputs[k] = std::sin(0.37 * k);
+    }
+
+    for (double breakEven : {0.0, 2.0})
+    {
+        ML::SparseNetwork sparse(network, breakEven);
+        std::vector<double> batchOut(batchSize * 4);
+        sparse.feedForwardBatch(inputs.data(), batchSize, batchOut.data());
+
+        for (std::size_t b = 0; b < batchSize; ++b)
+        {
+            std::vector<double> single(4);
+            sparse.feedForward(inputs.data() + b * 5, single.data());
+            for (std::size_t n = 0; n < 4; ++n)
+            {
+                ASSERT_NEAR(batchOut[b * 4 + n], single[n], 1e-12);
+            }
+        }
+    }
+}
+
+TEST(SparseTest, BreakEvenDensityIsAFraction)
+{
+    const double breakEven = ML::SparseNetwork::getBreakEvenDensity();
+    ASSERT_GE(breakEven, 0.0);
+    ASSERT_LT(breakEven, 1.0);
+}
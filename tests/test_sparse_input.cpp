@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include "Network.h"
+#include <cmath>
+#include <random>
+
+namespace
+{
+    std::vector<double> densify(const ML::SparseInput& input, std::size_t numInputs)
+    {
+        std::vector<double> dense(numInputs, 0.0);
+        for (std::size_t k = 0; k < input.indices.size(); ++k)
+            dense[input.indices[k]] = input.values[k];
+        return dense;
+    }
+
+    ML::SparseInput randomSparse(std::size_t numInputs, std::size_t count, std::mt19937& rng)
+    {
+        std::uniform_int_distribution<std::uint32_t> index(0, static_cast<std::uint32_t>(numInputs - 1));
+        std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+        ML::SparseInput input;
+        std::vector<bool> used(numInputs, false);
+        while (input.indices.size() < count)
+        {
+            const std::uint32_t i = index(rng);
+            if (used[i])
+                continue;
+            used[i] = true;
+            input.indices.push_back(i);
+            input.values.push_back(value(rng));
+        }
+        return input;
+    }
+}
+
+TEST(SparseInputTest, ForwardMatchesDense)
+{
+    const std::size_t numInputs = 500;
+    ML::Network sparse({500, 16, 8, 3}, ML::WeightInit::Xavier, 1);
+    ML::Network dense({500, 16, 8, 3}, ML::WeightInit::Xavier, 1);
+    std::mt19937 rng(2);
+
+    for (int trial = 0; trial < 5; ++trial)
+    {
+        const ML::SparseInput input = randomSparse(numInputs, 12, rng);
+        sparse.feedForwardSparse(input);
+        dense.feedForward(densify(input, numInputs));
+
+        std::vector<double> sparseOut, denseOut;
+        sparse.getResults(sparseOut);
+        dense.getResults(denseOut);
+        for (std::size_t o = 0; o < denseOut.size(); ++o)
+            ASSERT_NEAR(sparseOut[o], denseOut[o], 1e-12);
+    }
+
+    // A network with no hidden layer writes the output sums directly
+    ML::Network shallow({50, 2}, ML::WeightInit::Xavier, 3);
+    ML::Network shallowDense({50, 2}, ML::WeightInit::Xavier, 3);
+    const ML::SparseInput input = randomSparse(50, 4, rng);
+    shallow.feedForwardSparse(input);
+    shallowDense.feedForward(densify(input, 50));
+    std::vector<double> a, b;
+    shallow.getResults(a);
+    shallowDense.getResults(b);
+    ASSERT_NEAR(a[0], b[0], 1e-12);
+    ASSERT_NEAR(a[1], b[1], 1e-12);
+}
+
+TEST(SparseInputTest, FirstStepMatchesDenseTrainStep)
+{
+    const std::size_t numInputs = 300;
+    ML::Network sparse({300, 12, 2}, ML::WeightInit::Xavier, 4);
+    ML::Network dense({300, 12, 2}, ML::WeightInit::Xavier, 4);
+    std::mt19937 rng(5);
+
+    const ML::SparseInput input = randomSparse(numInputs, 10, rng);
+    const std::vector<double> target = {0.5, -0.25};
+    const double sparseError = sparse.trainStepSparse(input, target);
+    const double denseError = dense.trainStep(densify(input, numInputs), target);
+    ASSERT_NEAR(sparseError, denseError, 1e-12);
+
+    const std::vector<double> sparseWeights = sparse.getWeights();
+    const std::vector<double> denseWeights = dense.getWeights();
+    for (std::size_t w = 0; w < denseWeights.size(); ++w)
+        ASSERT_NEAR(sparseWeights[w], denseWeights[w], 1e-12);
+}
+
+TEST(SparseInputTest, OnlyListedRowsMove)
+{
+    const std::size_t numInputs = 1000, numHidden = 8;
+    ML::Network network({1000, 8, 1}, ML::WeightInit::Xavier, 6);
+    const std::vector<double> before = network.getWeights();
+
+    const ML::SparseInput first = {{3, 500, 999}, {1.0, 0.5, -1.0}};
+    const ML::SparseInput second = {{3, 42}, {1.0, 1.0}};
+    network.trainStepSparse(first, {0.8});
+    network.trainStepSparse(second, {-0.3});
+
+    const std::vector<double> after = network.getWeights();
+    for (std::size_t i = 0; i < numInputs; ++i)
+    {
+        const bool listed = i == 3 || i == 42 || i == 500 || i == 999;
+        for (std::size_t n = 0; n < numHidden; ++n)
+        {
+            if (listed)
+            {
+                ASSERT_NE(after[i * numHidden + n], before[i * numHidden + n]);
+            }
+            else
+            {
+                ASSERT_EQ(after[i * numHidden + n], before[i * numHidden + n]);
+            }
+        }
+    }
+}
+
+TEST(SparseInputTest, DenseCallsSeeTheSparseInputs)
+{
+    const std::size_t numInputs = 64;
+    ML::Network sparse({64, 6, 2}, ML::WeightInit::Xavier, 7);
+    ML::Network dense({64, 6, 2}, ML::WeightInit::Xavier, 7);
+    std::mt19937 rng(8);
+    const std::vector<double> target = {0.2, -0.4};
+
+    // backPropagate after a sparse forward uses the sparse inputs
+    const ML::SparseInput input = randomSparse(numInputs, 5, rng);
+    sparse.feedForwardSparse(input);
+    sparse.backPropagate(target);
+    dense.feedForward(densify(input, numInputs));
+    dense.backPropagate(target);
+
+    // A dense pass in between must not leave stale inputs behind for the next sparse one
+    std::vector<double> full(numInputs, 0.1);
+    sparse.feedForward(full);
+    dense.feedForward(full);
+
+    const ML::SparseInput next = randomSparse(numInputs, 5, rng);
+    sparse.feedForwardSparse(next);
+    sparse.backPropagate(target);
+    dense.feedForward(densify(next, numInputs));
+    dense.backPropagate(target);
+
+    const std::vector<double> a = sparse.getWeights(), b = dense.getWeights();
+    for (std::size_t w = 0; w < a.size(); ++w)
+        ASSERT_NEAR(a[w], b[w], 1e-12);
+}
+
+TEST(SparseInputTest, MixedPrecisionBackPropagateSeesTheSparsePass)
+{
+    const std::size_t numInputs = 64;
+    ML::Network sparse({64, 6, 2}, ML::WeightInit::Xavier, 13);
+    ML::Network dense({64, 6, 2}, ML::WeightInit::Xavier, 13);
+    sparse.setPrecision(ML::Precision::Mixed);
+    dense.setPrecision(ML::Precision::Mixed);
+    std::mt19937 rng(14);
+    const std::vector<double> target = {0.3, -0.1};
+
+    // backPropagateMixed reads the float working values, which the sparse pass must fill
+    for (int step = 0; step < 3; ++step)
+    {
+        const ML::SparseInput input = randomSparse(numInputs, 5, rng);
+        sparse.feedForwardSparse(input);
+        sparse.backPropagate(target);
+        dense.feedForward(densify(input, numInputs));
+        dense.backPropagate(target);
+    }
+
+    std::vector<double> a, b;
+    sparse.getResults(a);
+    dense.getResults(b);
+    ASSERT_EQ(a, b);
+    ASSERT_EQ(sparse.getWeights(), dense.getWeights());
+}
+
+TEST(SparseInputTest, LearnsHashedFeatures)
+{
+    // Each sample activates a handful of features out of 20000; the target is the sign of
+    // the sum of per-feature labels, so the model has to learn the listed rows
+    const std::size_t numInputs = 20000, numActive = 20;
+    ML::Network network({20000, 16, 1}, ML::WeightInit::Xavier, 9);
+    std::mt19937 rng(10);
+    std::uniform_int_distribution<int> coin(0, 1);
+    std::vector<double> featureSign(numInputs);
+    for (double& s : featureSign)
+        s = coin(rng) ? 1.0 : -1.0;
+
+    std::vector<ML::SparseInput> samples;
+    std::vector<std::vector<double>> targets;
+    for (int s = 0; s < 200; ++s)
+    {
+        ML::SparseInput input = randomSparse(numInputs, numActive, rng);
+        double sum = 0.0;
+        for (std::size_t k = 0; k < numActive; ++k)
+        {
+            input.values[k] = 1.0;
+            sum += featureSign[input.indices[k]];
+        }
+        samples.push_back(input);
+        targets.push_back({sum > 0.0 ? 0.8 : -0.8});
+    }
+
+    for (int epoch = 0; epoch < 30; ++epoch)
+        for (std::size_t s = 0; s < samples.size(); ++s)
+            network.trainStepSparse(samples[s], targets[s]);
+
+    int correct = 0;
+    std::vector<double> out;
+    for (std::size_t s = 0; s < samples.size(); ++s)
+    {
+        network.feedForwardSparse(samples[s]);
+        network.getResults(out);
+        correct += (out[0] > 0.0) == (targets[s][0] > 0.0);
+    }
+    ASSERT_GE(correct, 190);
+}
+
+TEST(SparseInputTest, TopologyChangeForgetsOldInputs)
+{
+    ML::Network network({1000, 4, 1}, ML::WeightInit::Xavier, 11);
+    network.feedForwardSparse(ML::SparseInput{{999, 700, 300}, {1.0, 1.0, 1.0}});
+
+    // The old indices lie far outside the new input layer
+    network.setTopology({2, 300, 1});
+    ML::Network dense({2, 300, 1});
+    dense.putWeights(network.getWeights());
+
+    network.feedForwardSparse(ML::SparseInput{{0}, {0.5}});
+    dense.feedForward({0.5, 0.0});
+
+    std::vector<double> a, b;
+    network.getResults(a);
+    dense.getResults(b);
+    ASSERT_EQ(a, b);
+    ASSERT_EQ(network.trainStepSparse(ML::SparseInput{{1}, {1.0}}, {0.5}), dense.trainStep({0.0, 1.0}, {0.5}));
+}
+
+TEST(SparseInputTest, MaskHoldsAndWeightNormIsRejected)
+{
+    ML::Network network({20, 4, 1}, ML::WeightInit::Xavier, 12);
+    std::vector<unsigned char> mask(network.getNumWeights(), 1);
+    mask[3 * 4 + 1] = 0;                        // a listed input's row
+    mask[network.getNumWeights() - 1] = 0;      // the output layer
+    network.setWeightMask(mask);
+
+    const ML::SparseInput input = {{3, 7}, {1.0, -1.0}};
+    for (int step = 0; step < 5; ++step)
+        network.trainStepSparse(input, {0.7});
+    const std::vector<double> weights = network.getWeights();
+    ASSERT_EQ(weights[3 * 4 + 1], 0.0);
+    ASSERT_EQ(weights.back(), 0.0);
+
+    network.setWeightNorm(true);
+    const std::vector<double> before = network.getWeights();
+    ASSERT_TRUE(std::isnan(network.trainStepSparse(input, {0.7})));
+    ASSERT_EQ(network.getWeights(), before);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "Sweep.h"
+#include <algorithm>
+
+namespace
+{
+    const std::vector<ML::Sample> andGate = {
+        {{0, 0}, {0}},
+        {{0, 1}, {0}},
+        {{1, 0}, {0}},
+        {{1, 1}, {1}}
+    };
+}
+
+TEST(SweepTest, GridCoversEveryCombination)
+{
+    ML::SweepConfig base;
+    base.maxEpochs = 50;
+    const auto configs = ML::makeSweepGrid({{2, 2, 1}, {2, 4, 1}}, {ML::WeightInit::Uniform, ML::WeightInit::Xavier}, {1, 2, 3}, base);
+
+    ASSERT_EQ(configs.size(), 12u);
+    ASSERT_EQ(configs[0].topology, (std::vector<unsigned>{2, 2, 1}));
+    ASSERT_EQ(configs[11].topology, (std::vector<unsigned>{2, 4, 1}));
+    ASSERT_EQ(configs[11].init, ML::WeightInit::Xavier);
+    ASSERT_EQ(configs[11].seed, 3u);
+    ASSERT_EQ(configs[11].maxEpochs, 50u);
+}
+
+TEST(SweepTest, ResultsIndependentOfThreadCount)
+{
+    ML::SweepConfig base;
+    base.maxEpochs = 200;
+    const auto configs = ML::makeSweepGrid({{2, 3, 1}, {2, 6, 1}}, {ML::WeightInit::Xavier}, {10, 11, 12, 13}, base);
+
+    const auto serial = ML::runSweep(configs, andGate, 1);
+    const auto parallel = ML::runSweep(configs, andGate, 4);
+
+    ASSERT_EQ(serial.size(), configs.size());
+    ASSERT_EQ(parallel.size(), configs.size());
+    for (std::size_t c = 0; c < configs.size(); ++c)
+    {
+        ASSERT_EQ(parallel[c].configIndex, c);
+        ASSERT_EQ(parallel[c].epochs, serial[c].epochs);
+        ASSERT_EQ(parallel[c].finalError, serial[c].finalError);
+        ASSERT_EQ(parallel[c].weights, serial[c].weights);
+    }
+}
+
+TEST(SweepTest, EarlyStoppingEndsTraining)
+{
+    ML::SweepConfig converging;
+    converging.topology = {2, 4, 1};
+    converging.init = ML::WeightInit::Xavier;
+    converging.seed = 5;
+    converging.maxEpochs = 100000;
+    converging.targetError = 0.05;
+
+    ML::SweepConfig plateauing = converging;
+    plateauing.targetError = 0.0;
+    plateauing.patience = 20;
+    plateauing.minImprovement = 1.0; // nothing improves by a whole unit
+
+    const auto results = ML::runSweep({converging, plateauing}, andGate);
+    ASSERT_EQ(results.size(), 2u);
+
+    ASSERT_EQ(results[0].status, ML::SweepStatus::Converged);
+    ASSERT_LE(results[0].finalError, 0.05);
+    ASSERT_LT(results[0].epochs, converging.maxEpochs);
+
+    ASSERT_EQ(results[1].status, ML::SweepStatus::Plateaued);
+    ASSERT_EQ(results[1].epochs, 21u);
+}
+
+TEST(SweepTest, MismatchedTopologyIsRejected)
+{
+    ML::SweepConfig config;
+    config.topology = {3, 2, 1};
+    ASSERT_TRUE(ML::runSweep({config}, andGate).empty());
+}
+
+TEST(SweepTest, TableHasOneRowPerResult)
+{
+    ML::SweepConfig base;
+    base.maxEpochs = 10;
+    const auto results = ML::runSweep(ML::makeSweepGrid({{2, 2, 1}}, {ML::WeightInit::He}, {1, 2}, base), andGate);
+    const std::string table = ML::formatSweepTable(results);
+
+    ASSERT_EQ(std::count(table.begin(), table.end(), '\n'), 3);
+    ASSERT_NE(table.find("2-2-1"), std::string::npos);
+    ASSERT_NE(table.find("max epochs"), std::string::npos);
+}
+
+TEST(SweepTest, LearningRateAndMomentumAxes)
+{
+    ML::SweepConfig base;
+    base.maxEpochs = 20;
+    base.targetError = 0.0;
+    const auto configs = ML::makeSweepGrid({{2, 3, 1}}, {ML::WeightInit::Xavier}, {7}, {0.05, 0.3}, {0.0, 0.9}, base);
+
+    ASSERT_EQ(configs.size(), 4u);
+    ASSERT_EQ(configs[0].learningRate, 0.05);
+    ASSERT_EQ(configs[0].momentum, 0.0);
+    ASSERT_EQ(configs[3].learningRate, 0.3);
+    ASSERT_EQ(configs[3].momentum, 0.9);
+    ASSERT_EQ(configs[3].maxEpochs, 20u);
+
+    // Each config trains with its own rate, exactly as a Perceptron set up by hand
+    const auto results = ML::runSweep(configs, andGate);
+    ASSERT_NE(results[0].weights, results[3].weights);
+
+    ML::Models::Perceptron perceptron({2, 3, 1}, ML::WeightInit::Xavier, 7);
+    perceptron.setLearningRate(0.3);
+    perceptron.setMomentum(0.9);
+    for (unsigned epoch = 0; epoch < 20; ++epoch)
+        for (const auto& [input, target] : andGate)
+            perceptron.trainStep(input, target);
+    ASSERT_EQ(perceptron.getWeights(), results[3].weights);
+}
@@ -0,0 +1,553 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+// End-to-end training benchmarks: the logic-gate and adder tasks from the perceptron
+// tests, plus synthetic regression and classification sets. Every task trains from a
+// fixed seed with Network::trainStep, one sample at a time, until its epoch error reaches
+// the task's target or it runs out of epochs. Results go out as JSON, and can be
+// compared against an earlier run to catch regressions.
+//
+// Usage: TinyMLBenchmark [--samples N] [--max-epochs N] [--repeat N] [--task NAME]
+//                        [--out FILE] [--baseline FILE] [--threshold FRACTION]
+//
+//  --samples     Size of the synthetic datasets (default 2000)
+//  --max-epochs  Epoch limit for the synthetic tasks (default 200); the gates get 10000
+//  --repeat      Runs of each task; the fastest is reported (default 3). Training is
+//                deterministic, so only the timings differ between runs.
+//  --task        Only run tasks whose name contains NAME
+//  --out         Write the JSON here instead of to stdout
+//  --baseline    JSON from an earlier run to compare against; the exit status is 2 if
+//                any task regressed
+//  --threshold   Relative change that counts as a regression (default 0.10)
+//
+// Each run of a task happens in a forked child, so the peak RSS it reports is that task's
+// own (on top of what the parent held when it forked) and not the high-water mark of
+// every task before it.
+//
+// Build optimised (CMAKE_BUILD_TYPE=Release) for numbers worth comparing.
+
+#include "Network.h"
+#include "Evaluate.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    struct Task
+    {
+        std::string name;
+        std::vector<unsigned> topology;
+        ML::Loss loss = ML::Loss::MeanSquared;
+        std::vector<ML::Sample> dataset;
+        unsigned maxEpochs = 10000;
+        double targetError = 0.05;  // mean per-sample loss over an epoch
+        std::uint64_t seed = 1;
+    };
+
+    struct TaskResult
+    {
+        std::string name;
+        std::string topology;
+        std::size_t samples = 0;
+        unsigned epochs = 0;
+        double seconds = 0.0;
+        double samplesPerSecond = 0.0;
+        double epochsPerSecond = 0.0;
+        bool reachedTarget = false;
+        double timeToTarget = 0.0;
+        unsigned epochsToTarget = 0;
+        double finalError = 0.0;
+        long peakRssKb = 0;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    long peakRssKb()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage {};
+        getrusage (RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+        return usage.ru_maxrss;
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    // Each row gets an extra input fixed at 1. The bias neurons output 0, so without it the
+    // network maps an all-zero input to 0 and could never learn NAND, NOR or XNOR.
+    std::vector<ML::Sample> truthTable (unsigned numInputs, bool (*function) (unsigned))
+    {
+        std::vector<ML::Sample> table;
+        for (unsigned row = 0; row < (1u << numInputs); ++row)
+        {
+            std::vector<double> input (numInputs + 1, 1.0);
+            for (unsigned i = 0; i < numInputs; ++i)
+            {
+                input[i] = (row >> (numInputs - 1 - i)) & 1u;
+            }
+            table.push_back ({ input, { function (row) ? 1.0 : 0.0 } });
+        }
+        return table;
+    }
+
+    // A smooth two-output function of four inputs in [-1, 1]. It is odd, f (-x) = -f (x),
+    // like every function a network without working biases can represent.
+    std::vector<ML::Sample> makeRegression (std::size_t count, std::uint64_t seed)
+    {
+        ML::Random random (seed);
+        std::vector<ML::Sample> dataset;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::vector<double> x (4);
+            for (double& value : x)
+            {
+                value = random.uniform (-1.0, 1.0);
+            }
+            dataset.push_back ({ x, { 0.6 * std::sin (2.0 * x[0]) * std::cos (x[1]), 0.4 * (x[2] - x[3] * x[3] * x[3]) + 0.3 * x[1] * x[2] * x[3] } });
+        }
+        return dataset;
+    }
+
+    // Three interleaved spiral arms, one-hot targets
+    std::vector<ML::Sample> makeClassification (std::size_t count, std::uint64_t seed)
+    {
+        ML::Random random (seed);
+        std::vector<ML::Sample> dataset;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t arm = i % 3;
+            const double r = random.nextDouble();
+            const double angle = 4.0 * r + 2.0944 * static_cast<double> (arm) + random.uniform (-0.2, 0.2);
+            std::vector<double> target (3, 0.0);
+            target[arm] = 1.0;
+            dataset.push_back ({ { r * std::cos (angle), r * std::sin (angle) }, target });
+        }
+        return dataset;
+    }
+
+    std::vector<Task> makeTasks (std::size_t samples, unsigned maxEpochs)
+    {
+        struct Gate
+        {
+            const char* name;
+            unsigned numInputs;
+            bool (*function) (unsigned);
+        };
+
+        // The truth tables of tests/test_perceptron.cpp; rows count up with the first input most significant
+        const Gate gates[] = {
+            { "and", 2, [] (unsigned r) { return r == 3; } },
+            { "or", 2, [] (unsigned r) { return r != 0; } },
+            { "nand", 2, [] (unsigned r) { return r != 3; } },
+            { "nor", 2, [] (unsigned r) { return r == 0; } },
+            { "xor", 2, [] (unsigned r) { return r == 1 || r == 2; } },
+            { "xnor", 2, [] (unsigned r) { return r == 0 || r == 3; } },
+            { "half_adder_sum", 2, [] (unsigned r) { return r == 1 || r == 2; } },
+            { "half_adder_carry", 2, [] (unsigned r) { return r == 3; } },
+            { "full_adder_sum", 3, [] (unsigned r) { return (((r >> 2) ^ (r >> 1) ^ r) & 1u) != 0; } },
+            { "full_adder_carry", 3, [] (unsigned r) { return ((r >> 2) & 1u) + ((r >> 1) & 1u) + (r & 1u) >= 2; } },
+        };
+
+        std::vector<Task> tasks;
+        for (const Gate& gate : gates)
+        {
+            Task task;
+            task.name = std::string ("gate_") + gate.name;
+            task.topology = { gate.numInputs + 1, 2 * gate.numInputs, 1 };
+            task.dataset = truthTable (gate.numInputs, gate.function);
+            task.targetError = 0.02;
+            task.seed = 7;
+            tasks.push_back (std::move (task));
+        }
+
+        Task regression;
+        regression.name = "regression";
+        regression.topology = { 4, 16, 2 };
+        regression.dataset = makeRegression (samples, 11);
+        regression.maxEpochs = maxEpochs;
+        regression.targetError = 0.03;
+        regression.seed = 13;
+        tasks.push_back (std::move (regression));
+
+        Task classification;
+        classification.name = "classification";
+        classification.topology = { 2, 32, 3 };
+        classification.loss = ML::Loss::CategoricalCrossEntropy;
+        classification.dataset = makeClassification (samples, 17);
+        classification.maxEpochs = maxEpochs;
+        classification.targetError = 0.02;
+        classification.seed = 19;
+        tasks.push_back (std::move (classification));
+
+        return tasks;
+    }
+
+    std::string formatTopology (const std::vector<unsigned>& topology)
+    {
+        std::string text;
+        for (unsigned layerSize : topology)
+        {
+            text += (text.empty() ? "" : "-") + std::to_string (layerSize);
+        }
+        return text;
+    }
+
+    TaskResult runTask (const Task& task)
+    {
+        ML::Network network (task.topology, ML::WeightInit::Xavier, task.seed);
+        network.setLoss (task.loss);
+
+        TaskResult result;
+        result.name = task.name;
+        result.topology = formatTopology (task.topology);
+        result.samples = task.dataset.size();
+
+        const Clock::time_point start = Clock::now();
+        for (unsigned epoch = 0; epoch < task.maxEpochs; ++epoch)
+        {
+            double errorSum = 0.0;
+            for (const auto& [input, target] : task.dataset)
+            {
+                errorSum += network.trainStep (input.data(), target.data());
+            }
+            result.epochs = epoch + 1;
+            result.finalError = errorSum / static_cast<double> (task.dataset.size());
+
+            if (result.finalError <= task.targetError)
+            {
+                result.reachedTarget = true;
+                result.epochsToTarget = result.epochs;
+                result.timeToTarget = std::chrono::duration<double> (Clock::now() - start).count();
+                break;
+            }
+        }
+        result.seconds = std::chrono::duration<double> (Clock::now() - start).count();
+
+        result.samplesPerSecond = static_cast<double> (result.epochs * result.samples) / result.seconds;
+        result.epochsPerSecond = static_cast<double> (result.epochs) / result.seconds;
+        result.peakRssKb = peakRssKb();
+        return result;
+    }
+
+    // The measured part of a TaskResult, passed back from the child that ran the task
+    struct Measurements
+    {
+        unsigned epochs;
+        double seconds;
+        double samplesPerSecond;
+        double epochsPerSecond;
+        bool reachedTarget;
+        double timeToTarget;
+        unsigned epochsToTarget;
+        double finalError;
+        long peakRssKb;
+    };
+
+    TaskResult runTaskInChild (const Task& task)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        int channel[2];
+        if (pipe (channel) == 0)
+        {
+            const pid_t pid = fork();
+            if (pid == 0)
+            {
+                close (channel[0]);
+                const TaskResult r = runTask (task);
+                const Measurements m { r.epochs, r.seconds, r.samplesPerSecond, r.epochsPerSecond, r.reachedTarget,
+                                       r.timeToTarget, r.epochsToTarget, r.finalError, r.peakRssKb };
+                const bool sent = write (channel[1], &m, sizeof (m)) == static_cast<ssize_t> (sizeof (m));
+                _exit (sent ? 0 : 1);
+            }
+
+            close (channel[1]);
+            Measurements m {};
+            const bool received = pid > 0 && read (channel[0], &m, sizeof (m)) == static_cast<ssize_t> (sizeof (m));
+            close (channel[0]);
+            if (pid > 0)
+            {
+                waitpid (pid, nullptr, 0);
+            }
+
+            if (received)
+            {
+                TaskResult result;
+                result.name = task.name;
+                result.topology = formatTopology (task.topology);
+                result.samples = task.dataset.size();
+                result.epochs = m.epochs;
+                result.seconds = m.seconds;
+                result.samplesPerSecond = m.samplesPerSecond;
+                result.epochsPerSecond = m.epochsPerSecond;
+                result.reachedTarget = m.reachedTarget;
+                result.timeToTarget = m.timeToTarget;
+                result.epochsToTarget = m.epochsToTarget;
+                result.finalError = m.finalError;
+                result.peakRssKb = m.peakRssKb;
+                return result;
+            }
+        }
+        std::cerr << "Error: Unable to run " << task.name << " in a child process; its peak RSS is not reported\n";
+#endif
+        // In process, the high-water mark would include earlier tasks, so leave it out
+        TaskResult result = runTask (task);
+        result.peakRssKb = 0;
+        return result;
+    }
+
+    void writeJson (std::ostream& out, const std::vector<TaskResult>& results, std::size_t samples, unsigned maxEpochs)
+    {
+        out << std::setprecision (6);
+        out << "{\n  \"samples\": " << samples << ",\n  \"max_epochs\": " << maxEpochs
+            << ",\n  \"peak_rss_kb\": " << peakRssKb() << ",\n  \"tasks\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const TaskResult& r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"topology\": \"" << r.topology << "\", \"samples\": " << r.samples
+                << ", \"epochs\": " << r.epochs << ", \"seconds\": " << r.seconds
+                << ", \"samples_per_sec\": " << r.samplesPerSecond << ", \"epochs_per_sec\": " << r.epochsPerSecond
+                << ", \"reached_target\": " << (r.reachedTarget ? "true" : "false") << ", \"time_to_target_sec\": ";
+            if (r.reachedTarget)
+            {
+                out << r.timeToTarget;
+            }
+            else
+            {
+                out << "null";
+            }
+            out << ", \"epochs_to_target\": " << r.epochsToTarget << ", \"final_error\": " << r.finalError
+                << ", \"peak_rss_kb\": " << r.peakRssKb << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    // Reads back the "tasks" array writeJson produces: flat objects of strings, numbers,
+    // booleans and nulls. Numbers and booleans come back as numbers, null as NaN.
+    bool readBaseline (const std::string& path, std::map<std::string, std::map<std::string, double>>& tasks)
+    {
+        std::ifstream file (path);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+        const std::string text = contents.str();
+
+        std::size_t pos = text.find ("\"tasks\"");
+        if (pos == std::string::npos)
+        {
+            return false;
+        }
+
+        while ((pos = text.find_first_of ("{]", pos)) != std::string::npos && text[pos] == '{')
+        {
+            const std::size_t end = text.find ('}', pos);
+            if (end == std::string::npos)
+            {
+                return false;
+            }
+
+            std::string name;
+            std::map<std::string, double> fields;
+            std::size_t cursor = pos + 1;
+            while ((cursor = text.find ('"', cursor)) < end)
+            {
+                const std::size_t keyEnd = text.find ('"', cursor + 1);
+                const std::string key = text.substr (cursor + 1, keyEnd - cursor - 1);
+                std::size_t valueStart = text.find_first_not_of (" :", keyEnd + 1);
+
+                if (text[valueStart] == '"')
+                {
+                    const std::size_t valueEnd = text.find ('"', valueStart + 1);
+                    if (key == "name")
+                    {
+                        name = text.substr (valueStart + 1, valueEnd - valueStart - 1);
+                    }
+                    cursor = valueEnd + 1;
+                    continue;
+                }
+
+                const std::size_t valueEnd = text.find_first_of (",}", valueStart);
+                const std::string value = text.substr (valueStart, valueEnd - valueStart);
+                fields[key] = value == "true" ? 1.0 : value == "false" ? 0.0 : value == "null" ? std::nan ("") : std::atof (value.c_str());
+                cursor = valueEnd;
+            }
+
+            if (!name.empty())
+            {
+                tasks[name] = fields;
+            }
+            pos = end + 1;
+        }
+        return true;
+    }
+
+    double field (const std::map<std::string, double>& fields, const std::string& key)
+    {
+        const auto found = fields.find (key);
+        return found == fields.end() ? std::nan ("") : found->second;
+    }
+
+    // Reports every task that got slower, lost its target, or grew in memory by more than threshold
+    int compareWithBaseline (const std::vector<TaskResult>& results, const std::string& path, double threshold)
+    {
+        std::map<std::string, std::map<std::string, double>> baseline;
+        if (!readBaseline (path, baseline))
+        {
+            std::cerr << "Error: Unable to read baseline " << path << "\n";
+            return 1;
+        }
+
+        std::cerr << std::fixed << std::setprecision (1);
+        unsigned regressions = 0;
+        for (const TaskResult& r : results)
+        {
+            const auto found = baseline.find (r.name);
+            if (found == baseline.end())
+            {
+                std::cerr << r.name << ": not in baseline\n";
+                continue;
+            }
+            const std::map<std::string, double>& base = found->second;
+
+            std::vector<std::string> problems;
+            const double throughputChange = r.samplesPerSecond / field (base, "samples_per_sec") - 1.0;
+            if (throughputChange < -threshold)
+            {
+                problems.push_back ("samples/s " + std::to_string (static_cast<int> (std::round (throughputChange * 100))) + "%");
+            }
+
+            const double baseTimeToTarget = field (base, "time_to_target_sec");
+            if (!std::isnan (baseTimeToTarget))
+            {
+                if (!r.reachedTarget)
+                {
+                    problems.push_back ("no longer reaches the target error");
+                }
+                else if (r.timeToTarget > baseTimeToTarget * (1.0 + threshold))
+                {
+                    problems.push_back ("time to target +" + std::to_string (static_cast<int> (std::round ((r.timeToTarget / baseTimeToTarget - 1.0) * 100))) + "%");
+                }
+            }
+
+            const double baseRss = field (base, "peak_rss_kb");
+            if (baseRss > 0.0 && static_cast<double> (r.peakRssKb) > baseRss * (1.0 + threshold))
+            {
+                problems.push_back ("peak RSS +" + std::to_string (static_cast<int> (std::round ((r.peakRssKb / baseRss - 1.0) * 100))) + "%");
+            }
+
+            std::cerr << r.name << ": samples/s " << (throughputChange >= 0.0 ? "+" : "") << throughputChange * 100.0 << "%";
+            for (const std::string& problem : problems)
+            {
+                std::cerr << "  REGRESSION: " << problem;
+            }
+            std::cerr << "\n";
+            regressions += problems.empty() ? 0 : 1;
+        }
+
+        std::cerr << regressions << " of " << results.size() << " tasks regressed beyond " << threshold * 100.0 << "%\n";
+        return regressions == 0 ? 0 : 2;
+    }
+}
+
+int main (int argc, char** argv)
+{
+    std::size_t samples = 2000;
+    unsigned maxEpochs = 200;
+    unsigned repeat = 3;
+    std::string taskFilter, outPath, baselinePath;
+    double threshold = 0.10;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        const char* value = i + 1 < argc ? argv[++i] : "";
+
+        if (option == "--samples")
+            samples = std::strtoul (value, nullptr, 10);
+        else if (option == "--max-epochs")
+            maxEpochs = static_cast<unsigned> (std::strtoul (value, nullptr, 10));
+        else if (option == "--repeat")
+            repeat = static_cast<unsigned> (std::strtoul (value, nullptr, 10));
+        else if (option == "--task")
+            taskFilter = value;
+        else if (option == "--out")
+            outPath = value;
+        else if (option == "--baseline")
+            baselinePath = value;
+        else if (option == "--threshold")
+            threshold = std::atof (value);
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--samples N] [--max-epochs N] [--repeat N] [--task NAME]"
+                      << " [--out FILE] [--baseline FILE] [--threshold FRACTION]\n";
+            return 1;
+        }
+    }
+
+    if (samples == 0 || maxEpochs == 0 || repeat == 0)
+    {
+        std::cerr << "Error: --samples, --max-epochs and --repeat must be positive\n";
+        return 1;
+    }
+
+    std::vector<TaskResult> results;
+    for (const Task& task : makeTasks (samples, maxEpochs))
+    {
+        if (task.name.find (taskFilter) == std::string::npos)
+        {
+            continue;
+        }
+        results.push_back (runTaskInChild (task));
+        for (unsigned r = 1; r < repeat; ++r)
+        {
+            TaskResult rerun = runTaskInChild (task);
+            if (rerun.seconds < results.back().seconds)
+            {
+                results.back() = rerun;
+            }
+        }
+        std::cerr << task.name << ": " << results.back().epochs << " epochs, " << std::setprecision (4)
+                  << results.back().samplesPerSecond << " samples/s\n";
+    }
+
+    if (outPath.empty())
+    {
+        writeJson (std::cout, results, samples, maxEpochs);
+    }
+    else
+    {
+        std::ofstream out (outPath);
+        writeJson (out, results, samples, maxEpochs);
+        if (!out)
+        {
+            std::cerr << "Error: Unable to write " << outPath << "\n";
+            return 1;
+        }
+    }
+
+    return baselinePath.empty() ? 0 : compareWithBaseline (results, baselinePath, threshold);
+}
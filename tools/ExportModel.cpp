@@ -0,0 +1,50 @@
+//****************************************************************************
+/* Copyright (C) Abhishek Shivakumar - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ * Written by Abhishek Shivakumar <abhishek.shivakumar@gmail.com>, 19/10/2026
+*****************************************************************************/
+
+// Compile a saved model into a standalone C++ header.
+//
+// Usage: TinyMLExport <topology, e.g. 2,4,1> <weights file> <output header> [namespace]
+
+#include "CodeGen.h"
+#include <iostream>
+#include <sstream>
+
+int main (int argc, char** argv)
+{
+    if (argc < 4 || argc > 5)
+    {
+        std::cerr << "Usage: " << argv[0] << " <topology, e.g. 2,4,1> <weights file> <output header> [namespace]\n";
+        return 1;
+    }
+
+    std::vector<unsigned> topology;
+    std::istringstream layers (argv[1]);
+    for (std::string layerSize; std::getline (layers, layerSize, ',');)
+    {
+        const unsigned long size = std::strtoul (layerSize.c_str(), nullptr, 10);
+        if (size == 0)
+        {
+            std::cerr << "Error: Invalid topology " << argv[1] << "\n";
+            return 1;
+        }
+        topology.push_back (static_cast<unsigned> (size));
+    }
+
+    if (topology.size() < 2)
+    {
+        std::cerr << "Error: A topology needs at least an input and an output layer\n";
+        return 1;
+    }
+
+    ML::Model model (topology);
+    if (!model.loadWeightsFromFile (argv[2]))
+    {
+        return 1;
+    }
+
+    return ML::exportModelHeader (model, argv[3], argc == 5 ? argv[4] : "tinyml_model") ? 0 : 1;
+}